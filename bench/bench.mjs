@@ -0,0 +1,291 @@
+// Headless benchmarks, run the wasm build under node:
+//
+//     ./build.sh && tsc && node bench/bench.mjs [scenario] [frames]
+//
+// Each scenario prints ms per frame for a model spinning like in index.ts.
+import { existsSync, readFileSync } from "node:fs";
+
+import { WasmRasterizer } from "../js/rasterizer.js";
+import { decodePNG } from "./png.mjs";
+
+const root = new URL("..", import.meta.url);
+const read = (path) => readFileSync(new URL(path, root));
+
+const imageWidth = 800;
+const imageHeight = 800;
+const imageChannels = 4;
+
+const createRasterizer = async (
+    frameCount = 2,
+    samples = 1,
+    depthFormat = 0,
+) => {
+    const rasterizer = new WasmRasterizer();
+    await rasterizer.initializeWasmBytes(read("wasm/rasterizer.wasm"));
+    rasterizer.initializeBuffers(
+        imageWidth,
+        imageHeight,
+        imageChannels,
+        frameCount,
+        samples,
+        depthFormat,
+    );
+    rasterizer.setCamera(20.0, [0.0, 0.0, 0.0], [0.0, 0.0, -1.0], [0, 1, 0]);
+    return rasterizer;
+};
+
+const pushHead = (rasterizer, texturePath = "img/head_texture_smol.png") => {
+    rasterizer.pushEntitySource(
+        read("3d/head.obj").toString(),
+        decodePNG(read(texturePath)),
+        [0.0, 0.0, -3.0],
+        [0.0, 0.0, 0.0],
+        1.0,
+    );
+};
+
+const pushDiablo = (rasterizer) => {
+    rasterizer.pushEntitySource(
+        read("3d/diablo3_pose.obj").toString(),
+        decodePNG(read("img/diablo3_pose_diffuse.png")),
+        [0.0, 0.0, -3.0],
+        [0.0, 0.0, 0.0],
+        1.0,
+    );
+};
+
+const measure = (name, frames, step) => {
+    for (let i = 0; i < 10; i++) {
+        step();
+    }
+
+    const times = [];
+    for (let i = 0; i < frames; i++) {
+        const start = performance.now();
+        step();
+        times.push(performance.now() - start);
+    }
+    times.sort((a, b) => a - b);
+
+    const mean = times.reduce((a, b) => a + b, 0) / times.length;
+    const p50 = times[Math.floor(times.length * 0.5)];
+    const p95 = times[Math.floor(times.length * 0.95)];
+    console.log(
+        `${name.padEnd(24)} mean ${mean.toFixed(3)} ms  ` +
+            `p50 ${p50.toFixed(3)} ms  p95 ${p95.toFixed(3)} ms`,
+    );
+};
+
+// 1x1 texture for scenarios timing the model alone
+const blankTexture = { width: 1, height: 1, data: new Uint8Array(4) };
+
+const scenarios = {
+    // rotate and render every frame
+    frame: async (frames) => {
+        const rasterizer = await createRasterizer();
+        pushHead(rasterizer);
+        measure("frame", frames, () => {
+            rasterizer.rotateEntity(0, [0.0, 5.0, 0.0]);
+            rasterizer.render();
+        });
+    },
+
+    // nothing moves, render() should be close to free
+    static: async (frames) => {
+        const rasterizer = await createRasterizer();
+        pushHead(rasterizer);
+        measure("static", frames, () => rasterizer.render());
+    },
+
+    // texel fetch bound: the 2844x2844 diablo texture in row major and in
+    // 4x4 blocks
+    texels: async (frames) => {
+        for (const blockShift of [0, 2]) {
+            const rasterizer = await createRasterizer();
+            rasterizer.textureBlockShift = blockShift;
+            pushDiablo(rasterizer);
+            const side = 1 << blockShift;
+            measure(`texels ${side}x${side}`, frames, () => {
+                rasterizer.rotateEntity(0, [0.0, 5.0, 0.0]);
+                rasterizer.render();
+            });
+        }
+    },
+
+    // nearest against bilinear on the same model
+    filter: async (frames) => {
+        for (const [name, filter] of [
+            ["nearest", 0],
+            ["bilinear", 1],
+        ]) {
+            const rasterizer = await createRasterizer();
+            rasterizer.textureFilter = filter;
+            pushDiablo(rasterizer);
+            measure(`filter ${name}`, frames, () => {
+                rasterizer.rotateEntity(0, [0.0, 5.0, 0.0]);
+                rasterizer.render();
+            });
+        }
+    },
+
+    // per pixel, gouraud and flat lighting
+    shading: async (frames) => {
+        for (const [name, shading] of [
+            ["pixel", 0],
+            ["gouraud", 1],
+            ["flat", 2],
+        ]) {
+            const rasterizer = await createRasterizer();
+            pushDiablo(rasterizer);
+            rasterizer.setEntityShading(0, shading);
+            measure(`shading ${name}`, frames, () => {
+                rasterizer.rotateEntity(0, [0.0, 5.0, 0.0]);
+                rasterizer.render();
+            });
+        }
+    },
+
+    // one sample against 4x multisampling, coverage and depth per sample
+    // with shading once per pixel
+    msaa: async (frames) => {
+        for (const samples of [1, 4]) {
+            const rasterizer = await createRasterizer(2, samples);
+            pushHead(rasterizer);
+            measure(`msaa ${samples}x`, frames, () => {
+                rasterizer.rotateEntity(0, [0.0, 5.0, 0.0]);
+                rasterizer.render();
+            });
+        }
+    },
+
+    // float, 16 and 24 bit integer depth, with one sample and 4x
+    // multisampling
+    depth: async (frames) => {
+        for (const samples of [1, 4]) {
+            for (const [name, depthFormat] of [
+                ["float32", 0],
+                ["unorm16", 1],
+                ["unorm24", 2],
+            ]) {
+                const rasterizer = await createRasterizer(
+                    2,
+                    samples,
+                    depthFormat,
+                );
+                pushDiablo(rasterizer);
+                measure(`depth ${name} ${samples}x`, frames, () => {
+                    rasterizer.rotateEntity(0, [0.0, 5.0, 0.0]);
+                    rasterizer.render();
+                });
+            }
+        }
+    },
+
+    // 4 overlapping diablos pushed far to near, the worst order for a
+    // single pass, against a depth prepass that leaves one shaded face a
+    // pixel. then depth alone, as for a shadow map
+    prepass: async (frames) => {
+        const texture = decodePNG(read("img/diablo3_pose_diffuse.png"));
+        const source = read("3d/diablo3_pose.obj").toString();
+        for (const [name, depthFormat] of [
+            ["float32", 0],
+            ["unorm16", 1],
+        ]) {
+            for (const mode of ["single", "prepass", "depth"]) {
+                const rasterizer = await createRasterizer(2, 1, depthFormat);
+                rasterizer.depthPrepass = mode === "prepass";
+                if (mode === "depth") {
+                    // the main camera's view, to compare against it
+                    rasterizer.setLightCamera(
+                        20.0,
+                        [0.0, 0.0, 0.0],
+                        [0.0, 0.0, -1.0],
+                        [0, 1, 0],
+                    );
+                }
+                for (let i = 0; i < 4; i++) {
+                    rasterizer.pushEntitySource(
+                        source,
+                        texture,
+                        [0.1 * i, 0.0, -4.5 + 0.5 * i],
+                        [0.0, 30.0 * i, 0.0],
+                        1.0,
+                    );
+                }
+                measure(`${mode} ${name}`, frames, () => {
+                    for (let i = 0; i < 4; i++) {
+                        rasterizer.rotateEntity(i, [0.0, 5.0, 0.0]);
+                    }
+                    if (mode === "depth") {
+                        rasterizer.renderDepth();
+                    } else {
+                        rasterizer.render();
+                    }
+                });
+            }
+        }
+    },
+
+    // float against 16 bit quantized vertices, in each shading mode
+    quantize: async (frames) => {
+        for (const quantize of [false, true]) {
+            for (const [name, shading] of [
+                ["pixel", 0],
+                ["gouraud", 1],
+                ["flat", 2],
+            ]) {
+                const rasterizer = await createRasterizer();
+                rasterizer.quantizeModels = quantize;
+                pushDiablo(rasterizer);
+                rasterizer.setEntityShading(0, shading);
+                const format = quantize ? "quantized" : "float";
+                measure(`${format} ${name}`, frames, () => {
+                    rasterizer.rotateEntity(0, [0.0, 5.0, 0.0]);
+                    rasterizer.render();
+                });
+            }
+        }
+    },
+
+    // pushing diablo from obj text, parsed by obj_parse, and from a baked
+    // mesh when there is one (make bake && ./bake 3d/diablo3_pose.obj
+    // 3d/diablo3_pose.mesh). every push keeps its object, so fewer frames
+    load: async (frames) => {
+        const sources = [["obj", read("3d/diablo3_pose.obj").toString()]];
+        if (existsSync(new URL("3d/diablo3_pose.mesh", root))) {
+            const mesh = read("3d/diablo3_pose.mesh");
+            sources.push([
+                "mesh",
+                mesh.buffer.slice(
+                    mesh.byteOffset,
+                    mesh.byteOffset + mesh.byteLength,
+                ),
+            ]);
+        }
+
+        for (const [name, source] of sources) {
+            const rasterizer = await createRasterizer();
+            measure(`load ${name}`, Math.min(frames, 50), () =>
+                rasterizer.pushEntitySource(
+                    source,
+                    blankTexture,
+                    [0.0, 0.0, -3.0],
+                    [0.0, 0.0, 0.0],
+                    1.0,
+                ),
+            );
+        }
+    },
+};
+
+const [scenario = "frame", frames = "200"] = process.argv.slice(2);
+
+const run = scenario === "all" ? Object.keys(scenarios) : [scenario];
+for (const name of run) {
+    if (!(name in scenarios)) {
+        console.error(`unknown scenario ${name}, one of:`);
+        console.error(`    all ${Object.keys(scenarios).join(" ")}`);
+        process.exit(1);
+    }
+    await scenarios[name](parseInt(frames));
+}
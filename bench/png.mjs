@@ -0,0 +1,103 @@
+// Minimal png decoder for the benchmarks, node has no canvas to decode
+// textures with. Supports 8 bit, non interlaced rgb and rgba images.
+import { inflateSync } from "node:zlib";
+
+const paeth = (a, b, c) => {
+    const p = a + b - c;
+    const pa = Math.abs(p - a);
+    const pb = Math.abs(p - b);
+    const pc = Math.abs(p - c);
+    if (pa <= pb && pa <= pc) {
+        return a;
+    }
+    return pb <= pc ? b : c;
+};
+
+export const decodePNG = (bytes) => {
+    const view = new DataView(bytes.buffer, bytes.byteOffset, bytes.length);
+
+    let width = 0,
+        height = 0,
+        channels = 0;
+    const idat = [];
+
+    for (let offset = 8; offset < bytes.length; ) {
+        const length = view.getUint32(offset);
+        const type = String.fromCharCode(
+            ...bytes.subarray(offset + 4, offset + 8),
+        );
+        const data = bytes.subarray(offset + 8, offset + 8 + length);
+
+        if (type === "IHDR") {
+            width = view.getUint32(offset + 8);
+            height = view.getUint32(offset + 12);
+            const bitDepth = data[8];
+            const colorType = data[9];
+            const interlace = data[12];
+            if (bitDepth !== 8 || interlace !== 0) {
+                throw new Error(
+                    "unsupported png, must be 8 bit non interlaced",
+                );
+            }
+            if (colorType === 2) {
+                channels = 3;
+            } else if (colorType === 6) {
+                channels = 4;
+            } else {
+                throw new Error("unsupported png, must be rgb or rgba");
+            }
+        } else if (type === "IDAT") {
+            idat.push(data);
+        } else if (type === "IEND") {
+            break;
+        }
+        offset += length + 12;
+    }
+
+    const raw = inflateSync(Buffer.concat(idat));
+    const stride = width * channels;
+    const pixels = new Uint8Array(height * stride);
+
+    for (let y = 0; y < height; y++) {
+        const filter = raw[y * (stride + 1)];
+        const line = raw.subarray(y * (stride + 1) + 1, (y + 1) * (stride + 1));
+        const out = y * stride;
+        for (let x = 0; x < stride; x++) {
+            const a = x >= channels ? pixels[out + x - channels] : 0;
+            const b = y > 0 ? pixels[out + x - stride] : 0;
+            const c =
+                x >= channels && y > 0
+                    ? pixels[out + x - stride - channels]
+                    : 0;
+            let value = line[x];
+            switch (filter) {
+                case 1:
+                    value += a;
+                    break;
+                case 2:
+                    value += b;
+                    break;
+                case 3:
+                    value += (a + b) >> 1;
+                    break;
+                case 4:
+                    value += paeth(a, b, c);
+                    break;
+            }
+            pixels[out + x] = value;
+        }
+    }
+
+    if (channels === 4) {
+        return { width, height, data: pixels };
+    }
+
+    const rgba = new Uint8Array(width * height * 4);
+    for (let i = 0; i < width * height; i++) {
+        rgba[i * 4 + 0] = pixels[i * 3 + 0];
+        rgba[i * 4 + 1] = pixels[i * 3 + 1];
+        rgba[i * 4 + 2] = pixels[i * 3 + 2];
+        rgba[i * 4 + 3] = 255;
+    }
+    return { width, height, data: rgba };
+};
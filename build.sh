@@ -9,8 +9,27 @@ $WASI_SDK_PATH/bin/clang \
     -flto \
     -Wl,--no-entry \
     -Wl,--export=bump_malloc \
+    -Wl,--export=bump_reserve \
+    -Wl,--export=obj_parse \
+    -Wl,--export=obj_stream_begin \
+    -Wl,--export=obj_stream_buffer \
+    -Wl,--export=obj_stream_parse \
+    -Wl,--export=stl_parse \
+    -Wl,--export=stl_stream_parse \
+    -Wl,--export=glb_parse \
+    -Wl,--export=meshz_parse \
+    -Wl,--export=quantize_obj \
     -Wl,--export=rasterize_obj \
+    -Wl,--export=rasterize_obj_depth \
+    -Wl,--export=framebuffer_clear \
+    -Wl,--export=framebuffer_resolve \
+    -Wl,--export=framebuffer_resolve_depth \
+    -Wl,--export=framebuffer_occluded \
+    -Wl,--export=texture_levels_size \
+    -Wl,--export=texture_build_levels \
     -Wl,--export=cam \
+    -Wl,--export=light_cam \
+    -Wl,--export=camera_occluded \
     -Wl,--export=camera_initialize \
     -Wl,--export=look_from \
     -Wl,--export=look_at \
@@ -21,11 +40,13 @@ $WASI_SDK_PATH/bin/clang \
     -Wl,--export=obj_set_position \
     -Wl,--export=obj_set_rotation \
     -Wl,--export=obj_set_height \
+    -Wl,--export=obj_set_shading \
     -Wl,--export=test_func \
     -Wl,--lto-O3 \
     -Wl,--initial-memory=20971520 \
     -o wasm/rasterizer.wasm \
-    c/camera.c c/rasterizer.c -lm
+    c/camera.c c/framebuffer.c c/glb_parse.c c/meshz_parse.c c/mipmap.c \
+    c/obj_parse.c c/raster_kernel.c c/rasterizer.c c/sampler.c c/stl_parse.c -lm
 
 wasm2wat wasm/rasterizer.wasm > wasm/rasterizer.wat
 
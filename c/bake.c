@@ -0,0 +1,42 @@
+// bakes an obj or binary stl file into a mesh file, see mesh.h, or when
+// the output ends in .meshz compresses it, see meshz_parse.h
+//
+//     make bake && ./bake 3d/head.obj 3d/head.mesh
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "mesh.h"
+#include "meshz.h"
+#include "obj.h"
+#include "stl.h"
+
+static int has_extension(const char *filepath, const char *extension) {
+    size_t n = strlen(filepath), m = strlen(extension);
+    return n >= m && strcmp(filepath + n - m, extension) == 0;
+}
+
+int main(int argc, char **argv) {
+    if (argc != 3) {
+        fprintf(stderr,
+                "usage: %s <model.obj|model.stl> <out.mesh|out.meshz>\n",
+                argv[0]);
+        return 1;
+    }
+
+    object obj = has_extension(argv[1], ".stl") ? STL_read_file(argv[1])
+                                                : OBJ_read_file(argv[1]);
+    uint32_t size;
+    if (has_extension(argv[2], ".meshz")) {
+        size = meshz_write_file(argv[2], &obj);
+    } else {
+        mesh_write_file(argv[2], &obj);
+        size = mesh_layout(obj.vertex_count, obj.face_count).size;
+    }
+    printf("%s: %u vertices, %u faces, %u bytes\n", argv[2], obj.vertex_count,
+           obj.face_count, size);
+
+    OBJ_destroy(&obj);
+    return 0;
+}
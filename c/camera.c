@@ -1,160 +1,492 @@
 #include "camera.h"
 
 #include <math.h>
-#include <wasm_simd128.h>
 
 #include "float.h"
+#include "framebuffer.h"
+#include "mipmap.h"
 #include "obj.h"
+#include "raster_kernel.h"
+#include "sampler.h"
 #include "texture.h"
 #include "vec3.h"
 
-static void draw_triangle(vec2i t0, vec2i t1, vec2i t2, triangle t,
-                          uint8_t *image_buffer, float *z_buffer,
-                          uint32_t image_height, uint32_t image_width,
-                          color color);
+static uint32_t select_face_level(raster_triangle *t, texture_image *texture);
 
-static void draw_obj_triangle(vec2i t0, vec2i t1, vec2i t2, obj_triangle *t,
-                              uint8_t *image_buffer, float *z_buffer,
-                              uint32_t image_height, uint32_t image_width,
-                              uint32_t image_channels, texture_image *texture);
+static face_setup setup_face(vec2i t0, vec2i t1, vec2i t2,
+                             uint32_t image_width, uint32_t image_height);
+
+static void project_obj(camera *c, object *obj);
+
+static face_setup sample_bbox(face_setup setup, framebuffer *fb);
 
 static vec3 light_dir = {0, 0, -1};
 
-void rasterize_stl(uint8_t *image_buffer, camera *c, float vertices[],
-                   uint32_t face_count, float *z_buffer, color color) {
-    uint32_t image_height = c->image_height;
-    uint32_t image_width = c->image_width;
+// packed rgba8 for objects drawn without a texture
+#define UNTEXTURED_COLOR 0xffc8c8c8
 
-    vec3 dir = vec3_sub(c->look_at, c->look_from);
-    float focal_length = vec3_length(dir);
+// intensity at which interpolated normals are lit for certain, a few
+// thousand times their rounding error
+#define LIT_MARGIN 1e-3f
 
-    triangle t;
-    for (uint32_t k = 0; k < face_count; ++k) {
-        t = *(triangle *)(vertices + (k * 12));
-        vec3 v1 = vec3_sub(t.v1, c->look_from);
-        vec3 v2 = vec3_sub(t.v2, c->look_from);
-        vec3 v3 = vec3_sub(t.v3, c->look_from);
-
-        vec3 v1t = vec3_sub(vec3_scalar_mult(v1, (focal_length * focal_length) /
-                                                     vec3_dot(dir, v1)),
-                            c->_viewport_upper_left);
-
-        vec2i v1_pixel = {
-            vec3_dot(c->_pixel_delta_u, v1t) /
-                vec3_length_squared(c->_pixel_delta_u),
-            vec3_dot(c->_pixel_delta_v, v1t) /
-                vec3_length_squared(c->_pixel_delta_v),
-        };
+void rasterize_obj(framebuffer *fb, camera *c, object *obj,
+                   texture_image *texture) {
+    if (obj->dirty || obj->camera_epoch != c->epoch) {
+        project_obj(c, obj);
+    }
 
-        vec3 v2t = vec3_sub(vec3_scalar_mult(v2, (focal_length * focal_length) /
-                                                     vec3_dot(dir, v2)),
-                            c->_viewport_upper_left);
+    // objects without texture coordinates, or drawn without a texture, get
+    // a flat colour
+    uint32_t textured = texture != NULL && obj->textured;
 
-        vec2i v2_pixel = {
-            vec3_dot(c->_pixel_delta_u, v2t) /
-                vec3_length_squared(c->_pixel_delta_u),
-            vec3_dot(c->_pixel_delta_v, v2t) /
-                vec3_length_squared(c->_pixel_delta_v),
-        };
+    // one sampler per mip level, set up once per draw
+    sampler samplers[TEXTURE_MAX_LEVELS];
+    uint32_t state = 0;
+    if (textured) {
+        for (uint32_t i = 0; i < texture->level_count; ++i) {
+            samplers[i] = sampler_create(texture, i, texture->address_mode);
+        }
 
-        vec3 v3t = vec3_sub(vec3_scalar_mult(v3, (focal_length * focal_length) /
-                                                     vec3_dot(dir, v3)),
-                            c->_viewport_upper_left);
-        vec2i v3_pixel = {
-            vec3_dot(c->_pixel_delta_u, v3t) /
-                vec3_length_squared(c->_pixel_delta_u),
-            vec3_dot(c->_pixel_delta_v, v3t) /
-                vec3_length_squared(c->_pixel_delta_v),
-        };
+        state |= RASTER_TEXTURED;
+        if (texture->filter == SAMPLER_BILINEAR) {
+            state |= RASTER_BILINEAR;
+        }
+    }
+    if (obj->shading == SHADING_PIXEL) {
+        state |= RASTER_PIXEL_LIGHTING;
+    }
+    if (fb->samples > 1) {
+        state |= RASTER_MSAA;
+    }
+    state |= fb->depth_format << RASTER_DEPTH_SHIFT;
+    raster_kernel kernel = raster_kernel_select(state);
 
-        float intensity = -vec3_dot(light_dir, t.n);
-        if (intensity > 0) {
-            draw_triangle(v1_pixel, v2_pixel, v3_pixel, t, image_buffer,
-                          z_buffer, image_height, image_width,
-                          vec3_scalar_mult(color, intensity));
+    object_face f;
+    raster_triangle t = {
+        .depth_near = c->depth_near,
+        .depth_far = c->depth_far,
+        .light_dir = light_dir,
+        .color = UNTEXTURED_COLOR,
+    };
+    for (uint32_t k = 0; k < obj->face_count; ++k) {
+        t.setup = obj->face_setups[k];
+        if (t.setup.bbox_min.x == t.setup.bbox_max.x) {
+            continue;
         }
+
+        if (fb->samples > 1) {
+            t.setup = sample_bbox(t.setup, fb);
+        }
+
+        f = object_face_at(obj, k);
+        uint32_t i1 = f.vertex_idxs[0];
+        uint32_t i2 = f.vertex_idxs[1];
+        uint32_t i3 = f.vertex_idxs[2];
+
+        screen_vertex s1 = obj->screen_vertices[i1];
+        screen_vertex s2 = obj->screen_vertices[i2];
+        screen_vertex s3 = obj->screen_vertices[i3];
+
+        t.p1 = s1.pixel;
+        t.p2 = s2.pixel;
+        t.p3 = s3.pixel;
+        t.z = (vec3){s1.z, s2.z, s3.z};
+        t.inv_w = (vec3){s1.inv_w, s2.inv_w, s3.inv_w};
+
+        // per vertex intensities, all the same for flat shading
+        if (obj->shading == SHADING_PIXEL) {
+            t.n1 = object_normal(obj, i1);
+            t.n2 = object_normal(obj, i2);
+            t.n3 = object_normal(obj, i3);
+        } else if (obj->shading == SHADING_GOURAUD) {
+            t.intensities = (vec3){
+                obj->vertex_intensities[i1],
+                obj->vertex_intensities[i2],
+                obj->vertex_intensities[i3],
+            };
+        } else {
+            float intensity = obj->face_intensities[k];
+            t.intensities = (vec3){intensity, intensity, intensity};
+        }
+
+        if (textured) {
+            t.vt1 = object_texture(obj, i1);
+            t.vt2 = object_texture(obj, i2);
+            t.vt3 = object_texture(obj, i3);
+
+            t.sampler = &samplers[select_face_level(&t, texture)];
+        }
+
+        framebuffer_touch(fb, t.setup.bbox_min, t.setup.bbox_max);
+        kernel(fb, &t);
     }
 }
 
-void rasterize_obj(uint8_t *image_buffer, camera *c, object *obj,
-                   texture_image *texture, float *z_buffer) {
-    uint32_t image_height = c->image_height;
-    uint32_t image_width = c->image_width;
-    uint32_t image_channels = c->image_channels;
+void rasterize_obj_depth(framebuffer *fb, camera *c, object *obj) {
+    if (obj->dirty || obj->camera_epoch != c->epoch) {
+        project_obj(c, obj);
+    }
 
-    vec3 dir = vec3_sub(c->look_at, c->look_from);
-    float focal_length = vec3_length(dir);
+    uint32_t state = fb->depth_format << RASTER_DEPTH_SHIFT;
+    if (fb->samples > 1) {
+        state |= RASTER_MSAA;
+    }
+    // only faces that can be partly unlit need the lit test, flat faces and
+    // gouraud faces lit at every vertex are lit everywhere
+    uint32_t lit_state = state | RASTER_LIT_ONLY;
+    if (obj->shading == SHADING_PIXEL) {
+        lit_state |= RASTER_PIXEL_LIGHTING;
+    }
+    raster_kernel plain_kernel = raster_depth_kernel_select(state);
+    raster_kernel lit_kernel = raster_depth_kernel_select(lit_state);
 
     object_face f;
-    obj_triangle t;
+    raster_triangle t = {
+        .depth_near = c->depth_near,
+        .depth_far = c->depth_far,
+        .light_dir = light_dir,
+    };
     for (uint32_t k = 0; k < obj->face_count; ++k) {
-        f = obj->faces[k];
+        t.setup = obj->face_setups[k];
+        if (t.setup.bbox_min.x == t.setup.bbox_max.x) {
+            continue;
+        }
 
-        vec3 n1 = obj->vertex_normals[f.vertex_normal_idxs[0]];
-        vec3 n2 = obj->vertex_normals[f.vertex_normal_idxs[1]];
-        vec3 n3 = obj->vertex_normals[f.vertex_normal_idxs[2]];
+        if (fb->samples > 1) {
+            t.setup = sample_bbox(t.setup, fb);
+        }
 
-        point3 p1 = obj->vertices[f.vertex_idxs[0]];
-        point3 p2 = obj->vertices[f.vertex_idxs[1]];
-        point3 p3 = obj->vertices[f.vertex_idxs[2]];
+        f = object_face_at(obj, k);
+        screen_vertex s1 = obj->screen_vertices[f.vertex_idxs[0]];
+        screen_vertex s2 = obj->screen_vertices[f.vertex_idxs[1]];
+        screen_vertex s3 = obj->screen_vertices[f.vertex_idxs[2]];
+
+        t.p1 = s1.pixel;
+        t.p2 = s2.pixel;
+        t.p3 = s3.pixel;
+        t.z = (vec3){s1.z, s2.z, s3.z};
+
+        raster_kernel kernel = plain_kernel;
+        if (obj->shading == SHADING_PIXEL) {
+            t.inv_w = (vec3){s1.inv_w, s2.inv_w, s3.inv_w};
+            t.n1 = object_normal(obj, f.vertex_idxs[0]);
+            t.n2 = object_normal(obj, f.vertex_idxs[1]);
+            t.n3 = object_normal(obj, f.vertex_idxs[2]);
+            // well clear of 0 at every vertex, rounding in the interpolated
+            // normal cannot take any pixel below it
+            if (-vec3_dot(light_dir, t.n1) < LIT_MARGIN ||
+                -vec3_dot(light_dir, t.n2) < LIT_MARGIN ||
+                -vec3_dot(light_dir, t.n3) < LIT_MARGIN) {
+                kernel = lit_kernel;
+            }
+        } else if (obj->shading == SHADING_GOURAUD) {
+            t.inv_w = (vec3){s1.inv_w, s2.inv_w, s3.inv_w};
+            t.intensities = (vec3){
+                obj->vertex_intensities[f.vertex_idxs[0]],
+                obj->vertex_intensities[f.vertex_idxs[1]],
+                obj->vertex_intensities[f.vertex_idxs[2]],
+            };
+            if (t.intensities.x < 0 || t.intensities.y < 0 ||
+                t.intensities.z < 0) {
+                kernel = lit_kernel;
+            }
+        }
 
-        vec2 vt1 = obj->vertex_textures[f.vertex_texture_idxs[0]];
-        vec2 vt2 = obj->vertex_textures[f.vertex_texture_idxs[1]];
-        vec2 vt3 = obj->vertex_textures[f.vertex_texture_idxs[2]];
+        framebuffer_touch(fb, t.setup.bbox_min, t.setup.bbox_max);
+        kernel(fb, &t);
+    }
+}
 
-        t = (obj_triangle){n1, n2, n3, p1, p2, p3, vt1, vt2, vt3};
+// minified triangles sample a smaller mip level, which keeps the texels
+// they read close together in memory
+static uint32_t select_face_level(raster_triangle *t, texture_image *texture) {
+    vec2i t0 = t->p1, t1 = t->p2, t2 = t->p3;
+    float pixel_area =
+        (t2.x - t0.x) * (t1.y - t0.y) - (t1.x - t0.x) * (t2.y - t0.y);
+    float uv_area = (t->vt3.x - t->vt1.x) * (t->vt2.y - t->vt1.y) -
+                    (t->vt2.x - t->vt1.x) * (t->vt3.y - t->vt1.y);
 
-        vec3 v1 = vec3_sub(p1, c->look_from);
-        vec3 v2 = vec3_sub(p2, c->look_from);
-        vec3 v3 = vec3_sub(p3, c->look_from);
+    return texture_select_level(texture, fabsf(uv_area), fabsf(pixel_area));
+}
 
-        vec3 v1t = vec3_sub(vec3_scalar_mult(v1, (focal_length * focal_length) /
-                                                     vec3_dot(dir, v1)),
-                            c->_viewport_upper_left);
+static screen_vertex project_vertex(camera *c, vec3 dir, float focal_length,
+                                    point3 p) {
+    vec3 v = vec3_sub(p, c->look_from);
+    float view_depth = vec3_dot(dir, v);
+
+    vec3 vt = vec3_sub(
+        vec3_scalar_mult(v, (focal_length * focal_length) / view_depth),
+        c->_viewport_upper_left);
+
+    return (screen_vertex){
+        .pixel =
+            {
+                vec3_dot(c->_pixel_delta_u, vt) /
+                    vec3_length_squared(c->_pixel_delta_u),
+                vec3_dot(c->_pixel_delta_v, vt) /
+                    vec3_length_squared(c->_pixel_delta_v),
+            },
+        .z = view_depth / -focal_length,
+        .inv_w = focal_length / view_depth,
+    };
+}
 
-        vec2i v1_pixel = {
-            vec3_dot(c->_pixel_delta_u, v1t) /
-                vec3_length_squared(c->_pixel_delta_u),
-            vec3_dot(c->_pixel_delta_v, v1t) /
-                vec3_length_squared(c->_pixel_delta_v),
-        };
+float camera_depth(const camera *c, point3 p) {
+    vec3 dir = vec3_sub(c->look_at, c->look_from);
+    return vec3_dot(dir, vec3_sub(p, c->look_from)) / -vec3_length(dir);
+}
 
-        vec3 v2t = vec3_sub(vec3_scalar_mult(v2, (focal_length * focal_length) /
-                                                     vec3_dot(dir, v2)),
-                            c->_viewport_upper_left);
+static face_setup setup_face(vec2i t0, vec2i t1, vec2i t2,
+                             uint32_t image_width, uint32_t image_height) {
+    // same as the denominator in barycentric, every pixel of a degenerate
+    // triangle would be rejected
+    int area = (t2.x - t0.x) * (t1.y - t0.y) - (t1.x - t0.x) * (t2.y - t0.y);
+    if (area == 0) {
+        return (face_setup){0};
+    }
 
-        vec2i v2_pixel = {
-            vec3_dot(c->_pixel_delta_u, v2t) /
-                vec3_length_squared(c->_pixel_delta_u),
-            vec3_dot(c->_pixel_delta_v, v2t) /
-                vec3_length_squared(c->_pixel_delta_v),
-        };
+    face_setup setup = {
+        .bbox_min =
+            {
+                fmaxf(0, fminf(t0.x, fminf(t1.x, t2.x))),
+                fmaxf(0, fminf(t0.y, fminf(t1.y, t2.y))),
+            },
+        .bbox_max =
+            {
+                fminf(image_width - 1, fmaxf(t0.x, fmaxf(t1.x, t2.x))),
+                fminf(image_height - 1, fmaxf(t0.y, fmaxf(t1.y, t2.y))),
+            },
+    };
+
+    if (setup.bbox_min.x >= setup.bbox_max.x ||
+        setup.bbox_min.y >= setup.bbox_max.y) {
+        return (face_setup){0};
+    }
+    return setup;
+}
+
+// the samples of a pixel sit up to 3/8 of a pixel above and left of it, so
+// the pixels just past the far vertices can still cover some
+static face_setup sample_bbox(face_setup setup, framebuffer *fb) {
+    setup.bbox_max.x = setup.bbox_max.x + 1 < (int)fb->width
+                           ? setup.bbox_max.x + 1
+                           : (int)fb->width;
+    setup.bbox_max.y = setup.bbox_max.y + 1 < (int)fb->height
+                           ? setup.bbox_max.y + 1
+                           : (int)fb->height;
+    return setup;
+}
+
+// faces wind counter clockwise, so the cross product of two edges points
+// out of the object
+static float face_intensity(object *obj, object_face f) {
+    point3 v1 = object_position(obj, f.vertex_idxs[0]);
+    point3 v2 = object_position(obj, f.vertex_idxs[1]);
+    point3 v3 = object_position(obj, f.vertex_idxs[2]);
+
+    vec3 n = vec3_cross(vec3_sub(v2, v1), vec3_sub(v3, v1));
+    float length = vec3_length(n);
+    if (length == 0) {
+        return -1;
+    }
+    return -vec3_dot(light_dir, n) / length;
+}
+
+// the rows of a quantized object's position dequantization, splatted
+typedef struct {
+    vec3v rows[3];
+    vec3v offset;
+} dequantize_rows;
+
+static dequantize_rows dequantize_splat(const object_dequantize *d) {
+    dequantize_rows r;
+    for (int i = 0; i < 3; ++i) {
+        r.rows[i] = vec3v_from_vec3(
+            (vec3){d->position.e[i][0], d->position.e[i][1],
+                   d->position.e[i][2]});
+    }
+    r.offset = vec3v_from_vec3(d->offset);
+    return r;
+}
+
+static point3 qposition(const object_qvertex *q) {
+    return (point3){q->position[0], q->position[1], q->position[2]};
+}
+
+// object_position for four vertices
+static vec3v gather_positions(const object *obj, const dequantize_rows *d,
+                              uint32_t i0, uint32_t i1, uint32_t i2,
+                              uint32_t i3) {
+    if (obj->qvertices == NULL) {
+        const object_vertex *v = obj->vertices;
+        return vec3v_gather(v[i0].position, v[i1].position, v[i2].position,
+                            v[i3].position);
+    }
+
+    const object_qvertex *q = obj->qvertices;
+    vec3v p = vec3v_gather(qposition(&q[i0]), qposition(&q[i1]),
+                           qposition(&q[i2]), qposition(&q[i3]));
+    return (vec3v){
+        .x = vf_add(vec3v_dot(d->rows[0], p), d->offset.x),
+        .y = vf_add(vec3v_dot(d->rows[1], p), d->offset.y),
+        .z = vf_add(vec3v_dot(d->rows[2], p), d->offset.z),
+    };
+}
+
+// project_vertex four vertices at a time, the rest one by one
+static void project_vertices(camera *c, vec3 dir, float focal_length,
+                             object *obj) {
+    vec3v look_from = vec3v_from_vec3(c->look_from);
+    vec3v dirv = vec3v_from_vec3(dir);
+    vec3v upper_left = vec3v_from_vec3(c->_viewport_upper_left);
+    vec3v delta_u = vec3v_from_vec3(c->_pixel_delta_u);
+    vec3v delta_v = vec3v_from_vec3(c->_pixel_delta_v);
+    v128_t focal = vf_splat(focal_length);
+    v128_t neg_focal = vf_splat(-focal_length);
+    v128_t focal_squared = vf_splat(focal_length * focal_length);
+    v128_t delta_u_squared = vf_splat(vec3_length_squared(c->_pixel_delta_u));
+    v128_t delta_v_squared = vf_splat(vec3_length_squared(c->_pixel_delta_v));
+
+    dequantize_rows d = dequantize_splat(&obj->dequantize);
+    int32_t x[4], y[4];
+    float z[4], inv_w[4];
+
+    uint32_t i = 0;
+    for (; i + 4 <= obj->vertex_count; i += 4) {
+        vec3v p = gather_positions(obj, &d, i, i + 1, i + 2, i + 3);
+        vec3v v = vec3v_sub(p, look_from);
+
+        v128_t view_depth = vec3v_dot(dirv, v);
+        vec3v vt = vec3v_sub(
+            vec3v_v128_mul(v, vf_div(focal_squared, view_depth)), upper_left);
+
+        v_store(x, vi_trunc(vf_div(vec3v_dot(delta_u, vt), delta_u_squared)));
+        v_store(y, vi_trunc(vf_div(vec3v_dot(delta_v, vt), delta_v_squared)));
+        v_store(z, vf_div(view_depth, neg_focal));
+        v_store(inv_w, vf_div(focal, view_depth));
+
+        for (int h = 0; h < 4; ++h) {
+            obj->screen_vertices[i + h] = (screen_vertex){
+                .pixel = {x[h], y[h]}, .z = z[h], .inv_w = inv_w[h]};
+        }
+    }
 
-        vec3 v3t = vec3_sub(vec3_scalar_mult(v3, (focal_length * focal_length) /
-                                                     vec3_dot(dir, v3)),
-                            c->_viewport_upper_left);
-        vec2i v3_pixel = {
-            vec3_dot(c->_pixel_delta_u, v3t) /
-                vec3_length_squared(c->_pixel_delta_u),
-            vec3_dot(c->_pixel_delta_v, v3t) /
-                vec3_length_squared(c->_pixel_delta_v),
+    for (; i < obj->vertex_count; ++i) {
+        obj->screen_vertices[i] =
+            project_vertex(c, dir, focal_length, object_position(obj, i));
+    }
+}
+
+// face_intensity and the culling for four flat shaded faces at a time, only
+// the lit ones are set up. returns how many faces it did, the rest are left
+// to the caller
+static uint32_t setup_flat_faces(camera *c, object *obj) {
+    dequantize_rows d = dequantize_splat(&obj->dequantize);
+    vec3v light = vec3v_from_vec3(light_dir);
+    v128_t zero = vf_splat(0);
+    v128_t unlit = vf_splat(-1);
+
+    uint32_t k = 0;
+    for (; k + 4 <= obj->face_count; k += 4) {
+        object_face f[4] = {
+            object_face_at(obj, k),
+            object_face_at(obj, k + 1),
+            object_face_at(obj, k + 2),
+            object_face_at(obj, k + 3),
         };
 
-        draw_obj_triangle(v1_pixel, v2_pixel, v3_pixel, &t, image_buffer,
-                          z_buffer, image_height, image_width, image_channels,
-                          texture);
+        vec3v p[3];
+        for (int h = 0; h < 3; ++h) {
+            p[h] = gather_positions(obj, &d, f[0].vertex_idxs[h],
+                                    f[1].vertex_idxs[h], f[2].vertex_idxs[h],
+                                    f[3].vertex_idxs[h]);
+        }
+
+        vec3v n = vec3v_cross(vec3v_sub(p[1], p[0]), vec3v_sub(p[2], p[0]));
+        v128_t length = vf_sqrt(vec3v_dot(n, n));
+        v128_t intensity = vf_div(vf_mul(vec3v_dot(light, n), unlit), length);
+
+        // degenerate faces come out nan, which fails the test like -1
+        v128_t lit = vf_ge(intensity, zero);
+        v_store(obj->face_intensities + k, v_bitselect(intensity, unlit, lit));
+
+        uint32_t mask = v_bitmask(lit);
+        for (int h = 0; h < 4; ++h) {
+            if (!(mask & (1u << h))) {
+                obj->face_setups[k + h] = (face_setup){0};
+                continue;
+            }
+            obj->face_setups[k + h] =
+                setup_face(obj->screen_vertices[f[h].vertex_idxs[0]].pixel,
+                           obj->screen_vertices[f[h].vertex_idxs[1]].pixel,
+                           obj->screen_vertices[f[h].vertex_idxs[2]].pixel,
+                           c->image_width, c->image_height);
+        }
+    }
+    return k;
+}
+
+// projects every vertex once and sets up every face, rasterize_obj reuses
+// the result until the object moves or the camera changes
+static void project_obj(camera *c, object *obj) {
+    vec3 dir = vec3_sub(c->look_at, c->look_from);
+    float focal_length = vec3_length(dir);
+
+    project_vertices(c, dir, focal_length, obj);
+
+    if (obj->shading == SHADING_GOURAUD) {
+        for (uint32_t i = 0; i < obj->vertex_count; ++i) {
+            obj->vertex_intensities[i] =
+                -vec3_dot(light_dir, object_normal(obj, i));
+        }
+    }
+
+    // flat shading culls before setup, in batches
+    uint32_t k = 0;
+    if (obj->shading == SHADING_FLAT) {
+        k = setup_flat_faces(c, obj);
     }
+
+    object_face f;
+    for (; k < obj->face_count; ++k) {
+        f = object_face_at(obj, k);
+        obj->face_setups[k] =
+            setup_face(obj->screen_vertices[f.vertex_idxs[0]].pixel,
+                       obj->screen_vertices[f.vertex_idxs[1]].pixel,
+                       obj->screen_vertices[f.vertex_idxs[2]].pixel,
+                       c->image_width, c->image_height);
+
+        // unlit pixels are not drawn, so faces lit nowhere are dropped here
+        if (obj->shading == SHADING_GOURAUD) {
+            if (obj->vertex_intensities[f.vertex_idxs[0]] < 0 &&
+                obj->vertex_intensities[f.vertex_idxs[1]] < 0 &&
+                obj->vertex_intensities[f.vertex_idxs[2]] < 0) {
+                obj->face_setups[k] = (face_setup){0};
+            }
+        } else if (obj->shading == SHADING_FLAT) {
+            obj->face_intensities[k] = face_intensity(obj, f);
+            if (obj->face_intensities[k] < 0) {
+                obj->face_setups[k] = (face_setup){0};
+            }
+        }
+    }
+
+    obj->dirty = 0;
+    obj->camera_epoch = c->epoch;
 }
 
 float look_from[3], look_at[3], vup[3];
 
 void camera_initialize(camera *c, uint32_t image_width, uint32_t image_height,
-                       uint32_t image_channels, float vfov) {
+                       uint32_t image_channels, float vfov, float depth_near,
+                       float depth_far) {
     c->image_width = image_width;
     c->image_height = image_height;
     c->image_channels = image_channels;
 
     c->vfov = vfov;
+    c->depth_near = depth_near;
+    c->depth_far = depth_far;
     c->look_from = *(vec3 *)look_from;
     c->look_at = *(vec3 *)look_at;
     c->vup = *(vec3 *)vup;
@@ -188,137 +520,113 @@ void camera_initialize(camera *c, uint32_t image_width, uint32_t image_height,
     c->_pixel00_loc = vec3_add(
         viewport_upper_left,
         vec3_scalar_mult(vec3_add(c->_pixel_delta_u, c->_pixel_delta_v), 0.5));
-}
-
-static vec3 barycentric(vec2i t0, vec2i t1, vec2i t2, vec3 P) {
-    vec3 u = vec3_cross((vec3){t2.x - t0.x, t1.x - t0.x, t0.x - P.x},
-                        (vec3){t2.y - t0.y, t1.y - t0.y, t0.y - P.y});
 
-    if (fabsf(u.z) < 1) {
-        return (vec3){-1, 1, 1};
-    }
-    return (vec3){1 - (u.x + u.y) / u.z, u.y / u.z, u.x / u.z};
+    // unique across cameras, an object drawn from another camera in between
+    // is projected again
+    static uint32_t epochs;
+    c->epoch = ++epochs;
 }
 
-static void draw_triangle(vec2i t0, vec2i t1, vec2i t2, triangle t,
-                          uint8_t *image_buffer, float *z_buffer,
-                          uint32_t image_height, uint32_t image_width,
-                          color color) {
-    vec2 bbox_min = {FLT_MAX, FLT_MAX};
-    vec2 bbox_max = {-FLT_MAX, -FLT_MAX};
-    vec2 clamp = {image_width - 1, image_height - 1};
-
-    bbox_min.x = fmaxf(0, fminf(t0.x, fminf(t1.x, t2.x)));
-    bbox_min.y = fmaxf(0, fminf(t0.y, fminf(t1.y, t2.y)));
-
-    bbox_max.x = fminf(clamp.x, fmaxf(t0.x, fmaxf(t1.x, t2.x)));
-    bbox_max.y = fminf(clamp.y, fmaxf(t0.y, fmaxf(t1.y, t2.y)));
-
-    vec3 P;
-    for (P.x = bbox_min.x; P.x < bbox_max.x; ++P.x) {
-        for (P.y = bbox_min.y; P.y < bbox_max.y; ++P.y) {
-            vec3 bc_screen = barycentric(t0, t1, t2, P);
-            if (bc_screen.x < 0 || bc_screen.y < 0 || bc_screen.z < 0) {
-                continue;
-            }
-            P.z = t.v1.z * bc_screen.x + t.v2.z * bc_screen.y +
-                  t.v3.z * bc_screen.z;
-
-            int image_idx = P.x * image_height * 4 + P.y * 4;
-            if (image_idx >= image_height * image_width * 4 || image_idx < 0) {
-                continue;
-            }
-            int z_buffer_idx = P.x * image_height + P.y;
-            if (z_buffer[z_buffer_idx] > P.z) {
-                continue;
-            }
-            z_buffer[z_buffer_idx] = P.z;
-            // color = linear_to_gamma(color);
-            image_buffer[image_idx + 0] = color.x;  // r
-            image_buffer[image_idx + 1] = color.y;  // g
-            image_buffer[image_idx + 2] = color.z;  // b
-            image_buffer[image_idx + 3] = 255;      // a
-        }
+void place_obj(object *obj, uint32_t first_vertex, point3 center,
+               float scale, vec3 pos, vec3 rot) {
+    float theta_x = degrees_to_radians(rot.x);
+    float theta_y = degrees_to_radians(rot.y);
+    float theta_z = degrees_to_radians(rot.z);
+
+    // clang-format off
+    mat3 roll_rotation = {{
+        {1, 0             , 0            },
+        {0, cosf(theta_x) , sinf(theta_x)},
+        {0, -sinf(theta_x), cosf(theta_x)},
+    }};
+
+    mat3 pitch_rotation = {{
+        {cosf(theta_y), 0, -sinf(theta_y)},
+        {0            , 1, 0             },
+        {sinf(theta_y), 0, cosf(theta_y) },
+    }};
+
+    mat3 yaw_rotation = {{
+        {cosf(theta_z) , sinf(theta_z), 0},
+        {-sinf(theta_z), cosf(theta_z), 0},
+        {0             , 0            , 1},
+    }};
+    // clang-format on
+
+    // quantized vertices stay as they are, the transform goes into how
+    // they dequantize
+    if (obj->qvertices != NULL) {
+        mat3 rotation = mat3_mult(yaw_rotation,
+                                  mat3_mult(pitch_rotation, roll_rotation));
+        transform_quantized_obj(obj, rotation, scale, center, pos);
+        return;
     }
-}
 
-static void draw_obj_triangle(vec2i t0, vec2i t1, vec2i t2, obj_triangle *t,
-                              uint8_t *image_buffer, float *z_buffer,
-                              uint32_t image_height, uint32_t image_width,
-                              uint32_t image_channels, texture_image *texture) {
-    vec2 bbox_min = {FLT_MAX, FLT_MAX};
-    vec2 bbox_max = {-FLT_MAX, -FLT_MAX};
-    vec2 clamp = {image_width - 1, image_height - 1};
-
-    bbox_min.x = fmaxf(0, fminf(t0.x, fminf(t1.x, t2.x)));
-    bbox_min.y = fmaxf(0, fminf(t0.y, fminf(t1.y, t2.y)));
-
-    bbox_max.x = fminf(clamp.x, fmaxf(t0.x, fmaxf(t1.x, t2.x)));
-    bbox_max.y = fminf(clamp.y, fmaxf(t0.y, fmaxf(t1.y, t2.y)));
-
-    vec3 P, n, p_color;
-    for (P.x = bbox_min.x; P.x < bbox_max.x; ++P.x) {
-        for (P.y = bbox_min.y; P.y < bbox_max.y; ++P.y) {
-            vec3 bc_screen = barycentric(t0, t1, t2, P);
-            if (bc_screen.x < 0 || bc_screen.y < 0 || bc_screen.z < 0) {
-                continue;
-            }
-            P.z = t->v1.z * bc_screen.x + t->v2.z * bc_screen.y +
-                  t->v3.z * bc_screen.z;
+    vec3 v, n;
 
-            n = vec3_add3(vec3_scalar_mult(t->n1, bc_screen.x),
-                          vec3_scalar_mult(t->n2, bc_screen.y),
-                          vec3_scalar_mult(t->n3, bc_screen.z));
+    for (size_t i = first_vertex; i < obj->vertex_count; ++i) {
+        v = obj->vertices[i].position;
 
-            float intensity = -vec3_dot(light_dir, n);
-            if (intensity < 0) {
-                continue;
-            }
+        v = vec3_sub(v, center);                // center
+        v = vec3_scalar_mult(v, scale);         // scale
+        v = mat3_vec3_mult(roll_rotation, v);   // rotate
+        v = mat3_vec3_mult(pitch_rotation, v);  //
+        v = mat3_vec3_mult(yaw_rotation, v);    //
+        v = vec3_add(v, pos);                   // position
 
-            int image_idx =
-                P.y * image_width * image_channels + P.x * image_channels;
-            if (image_idx >= image_height * image_width * 4 || image_idx < 0) {
-                continue;
-            }
+        obj->vertices[i].position = v;
 
-            int z_buffer_idx = P.x * image_height + P.y;
-            if (z_buffer[z_buffer_idx] > P.z) {
-                continue;
-            }
+        n = obj->vertices[i].normal;
 
-            vec2 texture_nidx =
-                vec2_add3(vec2_scalar_mult(t->vt1, bc_screen.x),
-                          vec2_scalar_mult(t->vt2, bc_screen.y),
-                          vec2_scalar_mult(t->vt3, bc_screen.z));
+        n = mat3_vec3_mult(roll_rotation, n);
+        n = mat3_vec3_mult(pitch_rotation, n);
+        n = mat3_vec3_mult(yaw_rotation, n);
 
-            uint8_t *color =
-                get_pixel_from_norm(texture, texture_nidx.x, texture_nidx.y);
+        obj->vertices[i].normal = n;
+    }
 
-            p_color = (vec3){color[0], color[1], color[2]};
+    obj->dirty = 1;
+}
 
-            p_color = (vec3_scalar_mult(p_color, intensity));
+void transform_quantized_obj(object *obj, mat3 rotation, float scale,
+                             vec3 from, vec3 to) {
+    object_dequantize *d = &obj->dequantize;
 
-            z_buffer[z_buffer_idx] = P.z;
-            image_buffer[image_idx + 0] = p_color.x;  // r
-            image_buffer[image_idx + 1] = p_color.y;  // g
-            image_buffer[image_idx + 2] = p_color.z;  // b
-            image_buffer[image_idx + 3] = 255;        // a
+    mat3 position = mat3_mult(rotation, d->position);
+    for (int i = 0; i < 3; ++i) {
+        for (int j = 0; j < 3; ++j) {
+            position.e[i][j] *= scale;
         }
     }
-}
+    d->position = position;
 
-uint8_t *get_pixel_from_norm(texture_image *ti, float nx, float ny) {
-    uint32_t x = (ti->image_width - 1) * (1 - ny);
-    uint32_t y = (ti->image_height - 1) * nx;
+    vec3 offset = vec3_scalar_mult(vec3_sub(d->offset, from), scale);
+    d->offset = vec3_add(mat3_vec3_mult(rotation, offset), to);
 
-    size_t ti_idx =
-        ti->image_channels * x * ti->image_width + ti->image_channels * y;
-    return ti->image + ti_idx;
+    d->normal = mat3_mult(rotation, d->normal);
+
+    obj->dirty = 1;
 }
 
 void position_and_scale_obj(object *obj, vec3 pos, vec3 rot, float height) {
     float max_y = -FLT_MAX, min_y = FLT_MAX;
     point3 center_grav = {0};
 
-    vec3 v, n;
+    vec3 v;
+
+    for (uint32_t i = 0; i < obj->vertex_count; ++i) {
+        v = object_position(obj, i);
+
+        max_y = fmaxf(v.y, max_y);
+        min_y = fminf(v.y, min_y);
+
+        center_grav = vec3_add(center_grav, v);
+    }
+
+    center_grav = vec3_scalar_divide(center_grav, obj->vertex_count);
+
+    float cur_height = max_y - min_y;
+    float height_adjust = height / cur_height;
+
+    place_obj(obj, 0, center_grav, height_adjust, pos, rot);
 }
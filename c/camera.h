@@ -1,11 +1,19 @@
 #ifndef CAMERA_H
 #define CAMERA_H
 
+#include "framebuffer.h"
 #include "obj.h"
 #include "texture.h"
 #include "vec3.h"
 
-// extern float look_from[3], look_at[3], vup[3];
+// camera_initialize reads the view from these, the js side writes them
+// through the wasm exports
+extern float look_from[3], look_at[3], vup[3];
+
+// object shading modes, cheapest last
+#define SHADING_PIXEL 0    // interpolate normals, light every pixel
+#define SHADING_GOURAUD 1  // light every vertex, interpolate the intensity
+#define SHADING_FLAT 2     // light every face once
 
 typedef struct {
     uint32_t image_width;
@@ -15,6 +23,10 @@ typedef struct {
     vec3 look_from;
     vec3 vup;
     float vfov;
+    // distances along the view the integer depth formats spread over,
+    // depth_far to 0 and depth_near to their largest value
+    float depth_near;
+    float depth_far;
 
     point3 _center;
     vec3 _viewport_upper_left;
@@ -25,17 +37,43 @@ typedef struct {
     vec3 _w;
     vec3 _u;
     vec3 _v;
+
+    // set by camera_initialize, unique across cameras. invalidates object
+    // screen space caches
+    uint32_t epoch;
 } camera;
 
-void rasterize_stl(uint8_t *image_buffer, camera *c, float vertices[],
-                   uint32_t face_count, float *z_buffer, color color);
+void rasterize_obj(framebuffer *fb, camera *c, object *obj,
+                   texture_image *texture);
 
-void rasterize_obj(uint8_t *image_buffer, camera *c, object *obj,
-                   texture_image *texture, float *z_buffer);
+// the pixels rasterize_obj would draw, into depth alone, unlit ones left
+// out the same way. as a prepass it leaves rasterize_obj shading each pixel
+// once, only the nearest face passes the depth test. from a light's camera
+// it draws a shadow map, and any framebuffer it drew into answers
+// framebuffer_occluded
+void rasterize_obj_depth(framebuffer *fb, camera *c, object *obj);
 
 void camera_initialize(camera *c, uint32_t image_width, uint32_t image_height,
-                       uint32_t image_channels, float vfov);
+                       uint32_t image_channels, float vfov, float depth_near,
+                       float depth_far);
+
+// the depth p is stored at from c, minus its distance along the view, so
+// nearer is larger. what framebuffer_occluded compares against
+float camera_depth(const camera *c, point3 p);
 
+// moves the object's center of gravity to pos, scales it to height and
+// rotates it by rot degrees
 void position_and_scale_obj(object *obj, vec3 pos, vec3 rot, float height);
 
+// the transform position_and_scale_obj applies, given its center and scale,
+// for the vertices from first_vertex on. all of them for quantized objects
+void place_obj(object *obj, uint32_t first_vertex, point3 center,
+               float scale, vec3 pos, vec3 rot);
+
+// moves a quantized object, each position p to
+// rotation * (scale * (p - from)) + to, by changing how its vertices
+// dequantize. normals only rotate
+void transform_quantized_obj(object *obj, mat3 rotation, float scale,
+                             vec3 from, vec3 to);
+
 #endif  // CAMERA_H
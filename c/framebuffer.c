@@ -0,0 +1,214 @@
+#include "framebuffer.h"
+
+#include <math.h>
+#include <string.h>
+
+void framebuffer_clear(framebuffer *fb) {
+    memset(fb->tile_cleared, 0, fb->tiles_x * fb->tiles_y);
+}
+
+typedef struct {
+    uint32_t x0, y0, x1, y1;
+} tile_rect;
+
+static tile_rect tile_pixels(framebuffer *fb, uint32_t tx, uint32_t ty) {
+    tile_rect r = {
+        .x0 = tx * FRAMEBUFFER_TILE_SIZE,
+        .y0 = ty * FRAMEBUFFER_TILE_SIZE,
+    };
+    r.x1 = r.x0 + FRAMEBUFFER_TILE_SIZE;
+    r.y1 = r.y0 + FRAMEBUFFER_TILE_SIZE;
+    r.x1 = r.x1 < fb->width ? r.x1 : fb->width;
+    r.y1 = r.y1 < fb->height ? r.y1 : fb->height;
+    return r;
+}
+
+// clears what the raster kernels write: the samples when multisampled,
+// the image otherwise
+static void clear_tile(framebuffer *fb, uint32_t tx, uint32_t ty) {
+    tile_rect r = tile_pixels(fb, tx, ty);
+    uint32_t samples = fb->samples;
+
+    for (uint32_t y = r.y0; y < r.y1; ++y) {
+        uint32_t row = y * fb->width;
+
+        if (samples > 1) {
+            memset(fb->sample_colors + (row + r.x0) * samples, 0,
+                   (r.x1 - r.x0) * samples * sizeof(uint32_t));
+        } else {
+            memset(fb->image + (row + r.x0) * fb->channels, 0,
+                   (r.x1 - r.x0) * fb->channels);
+        }
+
+        if (fb->depth_format == DEPTH_FLOAT32) {
+            float *z = (float *)fb->z_buffer + row * samples;
+            for (uint32_t i = r.x0 * samples; i < r.x1 * samples; ++i) {
+                z[i] = -INFINITY;
+            }
+        } else {
+            uint32_t size = framebuffer_depth_size(fb->depth_format);
+            memset((uint8_t *)fb->z_buffer + (row + r.x0) * samples * size, 0,
+                   (r.x1 - r.x0) * samples * size);
+        }
+    }
+}
+
+static void clear_tile_image(framebuffer *fb, uint32_t tx, uint32_t ty) {
+    tile_rect r = tile_pixels(fb, tx, ty);
+    for (uint32_t y = r.y0; y < r.y1; ++y) {
+        memset(fb->image + (y * fb->width + r.x0) * fb->channels, 0,
+               (r.x1 - r.x0) * fb->channels);
+    }
+}
+
+// 65536 / covered samples, the alpha sum is always averaged over all 4
+static const uint32_t reciprocals[FRAMEBUFFER_MSAA_SAMPLES + 1] = {
+    0, 65536, 32768, 21846, 16384,
+};
+
+// the scalar path matches the wasm one bit for bit
+static inline uint32_t resolve_pixel(const uint32_t *samples) {
+#if defined(__wasm_simd128__)
+    v128_t s = v_load(samples);
+
+    // {s0 + s2, s1 + s3} in 16 bit lanes, then lanes 0..3 hold the sum of
+    // all four
+    v128_t sum = wasm_i16x8_add(wasm_u16x8_extend_low_u8x16(s),
+                                wasm_u16x8_extend_high_u8x16(s));
+    sum = wasm_i16x8_add(sum,
+                         wasm_i16x8_shuffle(sum, sum, 4, 5, 6, 7, 0, 1, 2, 3));
+
+    uint32_t covered = (wasm_u16x8_extract_lane(sum, 3) + 128) >> 8;
+    uint32_t reciprocal = reciprocals[covered];
+
+    v128_t color = wasm_i32x4_mul(
+        wasm_u32x4_extend_low_u16x8(sum),
+        wasm_i32x4_make(reciprocal, reciprocal, reciprocal, 16384));
+    color = wasm_u32x4_shr(color, 16);
+    color = wasm_u16x8_narrow_i32x4(color, color);
+    color = wasm_u8x16_narrow_i16x8(color, color);
+
+    return wasm_i32x4_extract_lane(color, 0);
+#else
+    uint32_t sums[4] = {0};
+    for (uint32_t i = 0; i < FRAMEBUFFER_MSAA_SAMPLES; ++i) {
+        for (uint32_t c = 0; c < 4; ++c) {
+            sums[c] += (samples[i] >> (c * 8)) & 0xff;
+        }
+    }
+
+    uint32_t reciprocal = reciprocals[(sums[3] + 128) >> 8];
+    return (sums[0] * reciprocal >> 16) | (sums[1] * reciprocal >> 16) << 8 |
+           (sums[2] * reciprocal >> 16) << 16 | (sums[3] * 16384 >> 16) << 24;
+#endif
+}
+
+// averages the 4 samples of every pixel. uncovered samples are cleared to
+// 0 and covered ones have an alpha of 255, so the alpha sum counts the
+// covered samples and the color is divided by that count instead of 4.
+// edges then keep their color and only fade out through alpha
+static void resolve_tile(framebuffer *fb, uint32_t tx, uint32_t ty) {
+    tile_rect r = tile_pixels(fb, tx, ty);
+    for (uint32_t y = r.y0; y < r.y1; ++y) {
+        uint32_t row = y * fb->width;
+        const uint32_t *samples =
+            fb->sample_colors + (row + r.x0) * FRAMEBUFFER_MSAA_SAMPLES;
+        uint32_t *image = (uint32_t *)(fb->image + row * fb->channels);
+
+        for (uint32_t x = r.x0; x < r.x1; ++x) {
+            image[x] = resolve_pixel(samples);
+            samples += FRAMEBUFFER_MSAA_SAMPLES;
+        }
+    }
+}
+
+void framebuffer_touch(framebuffer *fb, vec2i bbox_min, vec2i bbox_max) {
+    // bbox_max is exclusive, see draw_obj_triangle
+    uint32_t tx0 = bbox_min.x / FRAMEBUFFER_TILE_SIZE;
+    uint32_t ty0 = bbox_min.y / FRAMEBUFFER_TILE_SIZE;
+    uint32_t tx1 = (bbox_max.x - 1) / FRAMEBUFFER_TILE_SIZE;
+    uint32_t ty1 = (bbox_max.y - 1) / FRAMEBUFFER_TILE_SIZE;
+
+    for (uint32_t ty = ty0; ty <= ty1; ++ty) {
+        uint8_t *cleared = fb->tile_cleared + ty * fb->tiles_x;
+        for (uint32_t tx = tx0; tx <= tx1; ++tx) {
+            if (!cleared[tx]) {
+                clear_tile(fb, tx, ty);
+                cleared[tx] = 1;
+            }
+        }
+    }
+}
+
+void framebuffer_resolve(framebuffer *fb) {
+    // the depth of untouched tiles is never read before the next clear
+    for (uint32_t ty = 0; ty < fb->tiles_y; ++ty) {
+        uint8_t *cleared = fb->tile_cleared + ty * fb->tiles_x;
+        for (uint32_t tx = 0; tx < fb->tiles_x; ++tx) {
+            if (!cleared[tx]) {
+                clear_tile_image(fb, tx, ty);
+            } else if (fb->samples > 1) {
+                resolve_tile(fb, tx, ty);
+            }
+        }
+    }
+}
+
+void framebuffer_resolve_depth(framebuffer *fb) {
+    for (uint32_t ty = 0; ty < fb->tiles_y; ++ty) {
+        uint8_t *cleared = fb->tile_cleared + ty * fb->tiles_x;
+        for (uint32_t tx = 0; tx < fb->tiles_x; ++tx) {
+            if (!cleared[tx]) {
+                clear_tile(fb, tx, ty);
+                cleared[tx] = 1;
+            }
+        }
+    }
+}
+
+bool framebuffer_occluded(const framebuffer *fb, vec2i bbox_min,
+                          vec2i bbox_max, float depth, float depth_near,
+                          float depth_far) {
+    // nothing was drawn into a tile that is not cleared yet
+    uint32_t tx0 = bbox_min.x / FRAMEBUFFER_TILE_SIZE;
+    uint32_t ty0 = bbox_min.y / FRAMEBUFFER_TILE_SIZE;
+    uint32_t tx1 = (bbox_max.x - 1) / FRAMEBUFFER_TILE_SIZE;
+    uint32_t ty1 = (bbox_max.y - 1) / FRAMEBUFFER_TILE_SIZE;
+    for (uint32_t ty = ty0; ty <= ty1; ++ty) {
+        for (uint32_t tx = tx0; tx <= tx1; ++tx) {
+            if (!fb->tile_cleared[ty * fb->tiles_x + tx]) {
+                return false;
+            }
+        }
+    }
+
+    // depth in the stored format, rounded like the raster kernels round it
+    uint32_t units = 0;
+    if (fb->depth_format != DEPTH_FLOAT32) {
+        float max = fb->depth_format == DEPTH_UNORM16 ? DEPTH_UNORM16_MAX
+                                                     : DEPTH_UNORM24_MAX;
+        float d = (depth + depth_far) * (max / (depth_far - depth_near));
+        units = fminf(fmaxf(d + 0.5f, 0), max);
+    }
+
+    uint32_t samples = fb->samples;
+    for (int32_t y = bbox_min.y; y < bbox_max.y; ++y) {
+        uint32_t i0 = (y * fb->width + bbox_min.x) * samples;
+        uint32_t i1 = (y * fb->width + bbox_max.x) * samples;
+        for (uint32_t i = i0; i < i1; ++i) {
+            bool nearer;
+            if (fb->depth_format == DEPTH_FLOAT32) {
+                nearer = ((const float *)fb->z_buffer)[i] > depth;
+            } else if (fb->depth_format == DEPTH_UNORM16) {
+                nearer = ((const uint16_t *)fb->z_buffer)[i] > units;
+            } else {
+                nearer = (((const uint32_t *)fb->z_buffer)[i] &
+                          DEPTH_UNORM24_MAX) > units;
+            }
+            if (!nearer) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
@@ -0,0 +1,81 @@
+#ifndef FRAMEBUFFER_H
+#define FRAMEBUFFER_H
+
+#include "vec3.h"
+
+// 16 rgba pixels, one cache line per tile row
+#define FRAMEBUFFER_TILE_SIZE 16
+
+// samples per pixel of a multisampled framebuffer
+#define FRAMEBUFFER_MSAA_SAMPLES 4
+
+// depth formats. depth is minus the distance along the camera's view, the
+// integer ones map it over the camera's depth range, depth_far to 0 and
+// depth_near to their largest value, clamping what falls outside it.
+// cleared depth is -INFINITY or 0, so nearer is always larger
+#define DEPTH_FLOAT32 0  // float depth as is
+#define DEPTH_UNORM16 1  // uint16_t
+#define DEPTH_UNORM24 2  // low 24 bits of a uint32_t, the top 8 are spare
+#define DEPTH_FORMAT_COUNT 3
+
+#define DEPTH_UNORM16_MAX 0xffffu
+#define DEPTH_UNORM24_MAX 0xffffffu
+
+typedef struct {
+    uint32_t width;
+    uint32_t height;
+    uint32_t channels;
+
+    uint32_t tiles_x;
+    uint32_t tiles_y;
+
+    uint8_t *image;
+    // depth_format values, framebuffer_depth_size bytes each
+    void *z_buffer;
+
+    // one byte per tile, set once the tile is cleared in the current frame
+    uint8_t *tile_cleared;
+
+    // 1, or FRAMEBUFFER_MSAA_SAMPLES. a multisampled framebuffer keeps that
+    // many depths per pixel, next to each other, in z_buffer and as many
+    // rgba8 colors in sample_colors, and framebuffer_resolve averages them
+    // into image. bytes per pixel:
+    //     1 sample:  4 image + 4 depth                      =  8
+    //     4 samples: 4 image + 16 depth + 16 sample colors  = 36
+    uint32_t samples;
+    uint32_t *sample_colors;
+
+    // DEPTH_FLOAT32 keeps 4 bytes a sample, DEPTH_UNORM16 halves that. the
+    // spare bits of DEPTH_UNORM24 are cleared with the depth and kept by
+    // depth writes
+    uint32_t depth_format;
+} framebuffer;
+
+// bytes of one depth sample
+static inline uint32_t framebuffer_depth_size(uint32_t depth_format) {
+    return depth_format == DEPTH_UNORM16 ? 2 : 4;
+}
+
+// tiles are cleared lazily: framebuffer_clear only resets the tile flags,
+// framebuffer_touch clears the tiles a triangle is about to write, and
+// framebuffer_resolve fills the color of tiles nothing was drawn into and,
+// when multisampled, averages the samples of the others
+void framebuffer_clear(framebuffer *fb);
+
+void framebuffer_touch(framebuffer *fb, vec2i bbox_min, vec2i bbox_max);
+
+void framebuffer_resolve(framebuffer *fb);
+
+// clears the tiles nothing was drawn into, after which all of z_buffer
+// holds the frame's depth, e.g. to read a shadow map
+void framebuffer_resolve_depth(framebuffer *fb);
+
+// whether every sample in the box (bbox_max exclusive) is nearer than
+// depth, so anything inside it at depth or farther would be hidden. for
+// occlusion tests against a frame drawn with rasterize_obj_depth, with
+// depth from camera_depth and the range of the same camera
+bool framebuffer_occluded(const framebuffer *fb, vec2i bbox_min,
+                          vec2i bbox_max, float depth, float depth_near,
+                          float depth_far);
+
+#endif  // FRAMEBUFFER_H
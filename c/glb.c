@@ -0,0 +1,85 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include "glb.h"
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "camera.h"
+#include "glb_parse.h"
+#include "obj_parse.h"
+
+glb_file glb_open(const char *glb_filepath) {
+    int fd = open(glb_filepath, O_RDONLY);
+    struct stat st;
+    if (fd < 0 || fstat(fd, &st) != 0 || st.st_size == 0) {
+        fprintf(stderr, "error reading glb file: %s\n", glb_filepath);
+        exit(1);
+    }
+
+    // writable but private, nothing is written back to the file
+    size_t map_size = st.st_size;
+    uint8_t *map = (uint8_t *)mmap(NULL, map_size, PROT_READ | PROT_WRITE,
+                                   MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) {
+        fprintf(stderr, "error mapping glb file: %s\n", glb_filepath);
+        exit(1);
+    }
+
+    glb_mesh mesh;
+    if (!glb_read(map, map_size, &mesh)) {
+        munmap(map, map_size);
+        fprintf(stderr, "error invalid glb file: %s\n", glb_filepath);
+        exit(1);
+    }
+
+    glb_file glb = {0};
+    if (glb_in_place(&mesh)) {
+        void *cache =
+            malloc(obj_cache_size(mesh.vertex_count, mesh.face_count));
+        if (cache == NULL) {
+            munmap(map, map_size);
+            fprintf(stderr, "error malloc glb arena\n");
+            exit(1);
+        }
+
+        glb.obj = obj_from_arrays((object_vertex *)mesh.position.data,
+                                  (object_face *)mesh.indices,
+                                  mesh.vertex_count, mesh.face_count, cache);
+        glb_flip_textures(glb.obj.vertices, glb.obj.vertex_count);
+        glb.map = map;
+        glb.map_size = map_size;
+    } else {
+        void *arena =
+            malloc(obj_arena_size(mesh.vertex_count, mesh.face_count));
+        if (arena == NULL) {
+            munmap(map, map_size);
+            fprintf(stderr, "error malloc glb arena\n");
+            exit(1);
+        }
+
+        glb.obj = obj_from_arena(arena, mesh.vertex_count, mesh.face_count);
+        glb_copy(&mesh, glb.obj.vertices, glb.obj.faces);
+        munmap(map, map_size);
+    }
+
+    // gltf asks for flat shading when there are no normals
+    if (mesh.normal.data == NULL) {
+        glb.obj.shading = SHADING_FLAT;
+    }
+    glb.obj.textured = mesh.texture.data != NULL;
+    return glb;
+}
+
+void glb_close(glb_file *glb) {
+    free(glb->obj.arena);
+    if (glb->map != NULL) {
+        munmap(glb->map, glb->map_size);
+    }
+    *glb = (glb_file){0};
+}
@@ -0,0 +1,23 @@
+#ifndef GLB_H
+#define GLB_H
+
+#include <stddef.h>
+
+#include "obj.h"
+
+// a glb file mapped into memory, see glb_parse.h. when its buffers are
+// laid out as the object arrays the object points into the mapping, which
+// is private like a mesh file's, and only the screen space cache is
+// allocated. otherwise the arrays are copied out and map is NULL
+typedef struct {
+    object obj;
+
+    void *map;
+    size_t map_size;
+} glb_file;
+
+glb_file glb_open(const char *glb_filepath);
+
+void glb_close(glb_file *glb);
+
+#endif  // GLB_H
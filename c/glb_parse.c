@@ -0,0 +1,462 @@
+#include "glb_parse.h"
+
+#include <string.h>
+
+#define GLB_HEADER_SIZE 12
+#define GLB_CHUNK_HEADER_SIZE 8
+#define GLB_CHUNK_JSON 0x4e4f534a  // "JSON"
+#define GLB_CHUNK_BIN 0x004e4942   // "BIN\0"
+
+#define GLTF_UNSIGNED_BYTE 5121
+#define GLTF_UNSIGNED_SHORT 5123
+#define GLTF_UNSIGNED_INT 5125
+#define GLTF_FLOAT 5126
+#define GLTF_TRIANGLES 4
+
+// far deeper than gltf nests, bounds the recursion on hostile files
+#define JSON_MAX_DEPTH 64
+
+typedef struct {
+    const char *json;
+    const char *json_end;
+
+    uint8_t *bin;
+    uint32_t bin_size;
+} glb_chunks;
+
+// an accessor resolved to the bytes of its first element
+typedef struct {
+    uint8_t *data;
+    uint32_t stride;
+    uint32_t count;
+    uint32_t component_type;
+} glb_view;
+
+static uint32_t read_u32(const uint8_t *p) {
+    uint32_t v;
+    memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+// json, just enough to look values up. each function takes a pointer to
+// a value, NULL when there is none, and returns NULL on anything else
+
+static const char *json_space(const char *p, const char *end) {
+    while (p < end && (*p == ' ' || *p == '\t' || *p == '\n' || *p == '\r')) {
+        ++p;
+    }
+    return p;
+}
+
+static bool json_literal_char(char c) {
+    return (c >= '0' && c <= '9') || (c >= 'a' && c <= 'z') ||
+           (c >= 'A' && c <= 'Z') || c == '-' || c == '+' || c == '.';
+}
+
+// just past the value at p
+static const char *json_skip(const char *p, const char *end, int depth) {
+    p = json_space(p, end);
+    if (p == end || depth > JSON_MAX_DEPTH) {
+        return NULL;
+    }
+
+    if (*p == '"') {
+        for (++p; p < end; ++p) {
+            if (*p == '\\' && p + 1 < end) {
+                ++p;
+            } else if (*p == '"') {
+                return p + 1;
+            }
+        }
+        return NULL;
+    }
+
+    if (*p == '{' || *p == '[') {
+        char close = *p == '{' ? '}' : ']';
+        p = json_space(p + 1, end);
+        if (p < end && *p == close) {
+            return p + 1;
+        }
+        for (;;) {
+            if (close == '}') {
+                p = json_skip(p, end, depth + 1);
+                p = p != NULL ? json_space(p, end) : NULL;
+                if (p == NULL || p == end || *p != ':') {
+                    return NULL;
+                }
+                ++p;
+            }
+            p = json_skip(p, end, depth + 1);
+            p = p != NULL ? json_space(p, end) : NULL;
+            if (p == NULL || p == end) {
+                return NULL;
+            }
+            if (*p == close) {
+                return p + 1;
+            }
+            if (*p != ',') {
+                return NULL;
+            }
+            ++p;
+        }
+    }
+
+    // numbers, true, false and null
+    const char *start = p;
+    while (p < end && json_literal_char(*p)) {
+        ++p;
+    }
+    return p > start ? p : NULL;
+}
+
+// the value of key in the object at p. keys are compared as written,
+// gltf's have nothing to escape
+static const char *json_member(const char *p, const char *end,
+                               const char *key) {
+    p = p != NULL ? json_space(p, end) : NULL;
+    if (p == NULL || p == end || *p != '{') {
+        return NULL;
+    }
+    size_t n = strlen(key);
+
+    p = json_space(p + 1, end);
+    while (p < end && *p == '"') {
+        const char *k = p + 1;
+        p = json_skip(p, end, 0);
+        if (p == NULL) {
+            return NULL;
+        }
+        bool match = (size_t)(p - 1 - k) == n && memcmp(k, key, n) == 0;
+
+        p = json_space(p, end);
+        if (p == end || *p != ':') {
+            return NULL;
+        }
+        p = json_space(p + 1, end);
+        if (match) {
+            return p;
+        }
+
+        p = json_skip(p, end, 0);
+        p = p != NULL ? json_space(p, end) : NULL;
+        if (p == NULL || p == end || *p != ',') {
+            return NULL;
+        }
+        p = json_space(p + 1, end);
+    }
+    return NULL;
+}
+
+// element index of the array at p
+static const char *json_element(const char *p, const char *end,
+                                uint32_t index) {
+    p = p != NULL ? json_space(p, end) : NULL;
+    if (p == NULL || p == end || *p != '[') {
+        return NULL;
+    }
+
+    p = json_space(p + 1, end);
+    if (p < end && *p == ']') {
+        return NULL;
+    }
+    for (uint32_t i = 0; i < index; ++i) {
+        p = json_skip(p, end, 0);
+        p = p != NULL ? json_space(p, end) : NULL;
+        if (p == NULL || p == end || *p != ',') {
+            return NULL;
+        }
+        p = json_space(p + 1, end);
+    }
+    return p;
+}
+
+static bool json_uint(const char *p, const char *end, uint32_t *value) {
+    if (p == NULL) {
+        return false;
+    }
+
+    const char *start = p;
+    uint64_t v = 0;
+    while (p < end && *p >= '0' && *p <= '9') {
+        v = v * 10 + (*p - '0');
+        if (v > UINT32_MAX) {
+            return false;
+        }
+        ++p;
+    }
+    if (p == start || (p < end && json_literal_char(*p))) {
+        return false;
+    }
+
+    *value = (uint32_t)v;
+    return true;
+}
+
+// member key of the object at p, fallback when it has none
+static bool json_uint_or(const char *p, const char *end, const char *key,
+                         uint32_t fallback, uint32_t *value) {
+    const char *member = json_member(p, end, key);
+    if (member == NULL) {
+        *value = fallback;
+        return true;
+    }
+    return json_uint(member, end, value);
+}
+
+static bool json_string_is(const char *p, const char *end, const char *s) {
+    size_t n = strlen(s);
+    return p != NULL && (size_t)(end - p) >= n + 2 && p[0] == '"' &&
+           memcmp(p + 1, s, n) == 0 && p[n + 1] == '"';
+}
+
+static uint32_t component_size(uint32_t component_type) {
+    switch (component_type) {
+        case GLTF_UNSIGNED_BYTE:
+            return 1;
+        case GLTF_UNSIGNED_SHORT:
+            return 2;
+        case GLTF_UNSIGNED_INT:
+        case GLTF_FLOAT:
+            return 4;
+        default:
+            return 0;
+    }
+}
+
+// accessor index, which has to be of type with components components and
+// lie inside its buffer view, which has to lie inside the binary chunk
+static bool glb_accessor(const glb_chunks *f, uint32_t index, const char *type,
+                         uint32_t components, glb_view *view) {
+    const char *end = f->json_end;
+    const char *accessor =
+        json_element(json_member(f->json, end, "accessors"), end, index);
+
+    uint32_t buffer_view_index, offset, component_type, count;
+    if (accessor == NULL || json_member(accessor, end, "sparse") != NULL ||
+        !json_uint(json_member(accessor, end, "bufferView"), end,
+                   &buffer_view_index) ||
+        !json_uint_or(accessor, end, "byteOffset", 0, &offset) ||
+        !json_uint(json_member(accessor, end, "componentType"), end,
+                   &component_type) ||
+        !json_uint(json_member(accessor, end, "count"), end, &count) ||
+        !json_string_is(json_member(accessor, end, "type"), end, type)) {
+        return false;
+    }
+
+    uint32_t element_size = components * component_size(component_type);
+    const char *buffer_view = json_element(
+        json_member(f->json, end, "bufferViews"), end, buffer_view_index);
+
+    uint32_t buffer, view_offset, view_length, stride;
+    if (element_size == 0 || buffer_view == NULL ||
+        !json_uint(json_member(buffer_view, end, "buffer"), end, &buffer) ||
+        !json_uint_or(buffer_view, end, "byteOffset", 0, &view_offset) ||
+        !json_uint(json_member(buffer_view, end, "byteLength"), end,
+                   &view_length) ||
+        !json_uint_or(buffer_view, end, "byteStride", element_size,
+                      &stride) ||
+        buffer != 0 || stride < element_size) {
+        return false;
+    }
+
+    // in 64 bits, nothing here wraps
+    uint64_t used = (uint64_t)offset;
+    if (count > 0) {
+        used += (uint64_t)stride * (count - 1) + element_size;
+    }
+    if ((uint64_t)view_offset + view_length > f->bin_size ||
+        used > view_length) {
+        return false;
+    }
+
+    *view = (glb_view){
+        .data = f->bin + view_offset + offset,
+        .stride = stride,
+        .count = count,
+        .component_type = component_type,
+    };
+    return true;
+}
+
+// the float attribute name, left empty when the primitive has none
+static bool glb_attribute_read(const glb_chunks *f, const char *attributes,
+                               const char *name, const char *type,
+                               uint32_t components, uint32_t vertex_count,
+                               glb_attribute *attribute) {
+    const char *p = json_member(attributes, f->json_end, name);
+    if (p == NULL) {
+        *attribute = (glb_attribute){0};
+        return true;
+    }
+
+    uint32_t index;
+    glb_view view;
+    if (!json_uint(p, f->json_end, &index) ||
+        !glb_accessor(f, index, type, components, &view) ||
+        view.component_type != GLTF_FLOAT || view.count != vertex_count) {
+        return false;
+    }
+
+    *attribute = (glb_attribute){view.data, view.stride};
+    return true;
+}
+
+static uint32_t glb_index(const glb_mesh *mesh, uint32_t i) {
+    const uint8_t *p = mesh->indices + (size_t)i * mesh->index_size;
+    if (mesh->index_size == 1) {
+        return *p;
+    }
+    if (mesh->index_size == 2) {
+        uint16_t index;
+        memcpy(&index, p, sizeof(index));
+        return index;
+    }
+    return read_u32(p);
+}
+
+bool glb_read(uint8_t *bytes, size_t size, glb_mesh *mesh) {
+    if (size < GLB_HEADER_SIZE + GLB_CHUNK_HEADER_SIZE ||
+        read_u32(bytes) != GLB_MAGIC || read_u32(bytes + 4) != GLB_VERSION) {
+        return false;
+    }
+
+    // the chunks, json first and the binary one after it
+    uint32_t length = read_u32(bytes + 8);
+    uint32_t json_chunk = GLB_HEADER_SIZE + GLB_CHUNK_HEADER_SIZE;
+    if (length > size || length < json_chunk) {
+        return false;
+    }
+
+    uint32_t json_length = read_u32(bytes + GLB_HEADER_SIZE);
+    if (read_u32(bytes + GLB_HEADER_SIZE + 4) != GLB_CHUNK_JSON ||
+        json_length > length - json_chunk) {
+        return false;
+    }
+    glb_chunks f = {
+        .json = (const char *)bytes + json_chunk,
+        .json_end = (const char *)bytes + json_chunk + json_length,
+    };
+
+    uint32_t bin_chunk = json_chunk + json_length;
+    if (length - bin_chunk >= GLB_CHUNK_HEADER_SIZE &&
+        read_u32(bytes + bin_chunk + 4) == GLB_CHUNK_BIN) {
+        uint32_t bin_length = read_u32(bytes + bin_chunk);
+        if (bin_length > length - bin_chunk - GLB_CHUNK_HEADER_SIZE) {
+            return false;
+        }
+        f.bin = bytes + bin_chunk + GLB_CHUNK_HEADER_SIZE;
+        f.bin_size = bin_length;
+    }
+
+    // buffer 0 has to be the binary chunk, not a file of its own
+    const char *end = f.json_end;
+    const char *buffer =
+        json_element(json_member(f.json, end, "buffers"), end, 0);
+    if (buffer == NULL || json_member(buffer, end, "uri") != NULL) {
+        return false;
+    }
+
+    const char *gltf_mesh =
+        json_element(json_member(f.json, end, "meshes"), end, 0);
+    const char *primitive =
+        json_element(json_member(gltf_mesh, end, "primitives"), end, 0);
+    const char *attributes = json_member(primitive, end, "attributes");
+
+    uint32_t mode, index;
+    glb_view position;
+    if (attributes == NULL ||
+        !json_uint_or(primitive, end, "mode", GLTF_TRIANGLES, &mode) ||
+        mode != GLTF_TRIANGLES ||
+        !json_uint(json_member(attributes, end, "POSITION"), end, &index) ||
+        !glb_accessor(&f, index, "VEC3", 3, &position) ||
+        position.component_type != GLTF_FLOAT) {
+        return false;
+    }
+
+    *mesh = (glb_mesh){
+        .vertex_count = position.count,
+        .face_count = position.count / 3,
+        .position = {position.data, position.stride},
+    };
+    if (!glb_attribute_read(&f, attributes, "NORMAL", "VEC3", 3,
+                            mesh->vertex_count, &mesh->normal) ||
+        !glb_attribute_read(&f, attributes, "TEXCOORD_0", "VEC2", 2,
+                            mesh->vertex_count, &mesh->texture)) {
+        return false;
+    }
+
+    const char *p = json_member(primitive, end, "indices");
+    if (p == NULL) {
+        return true;
+    }
+
+    // index buffer views are tightly packed
+    glb_view indices;
+    if (!json_uint(p, end, &index) ||
+        !glb_accessor(&f, index, "SCALAR", 1, &indices) ||
+        indices.component_type == GLTF_FLOAT ||
+        indices.stride != component_size(indices.component_type)) {
+        return false;
+    }
+    mesh->indices = indices.data;
+    mesh->index_size = indices.stride;
+    mesh->face_count = indices.count / 3;
+
+    // the one pass over the indices, the faces may be used in place
+    for (uint32_t i = 0; i < 3 * mesh->face_count; ++i) {
+        if (glb_index(mesh, i) >= mesh->vertex_count) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool glb_in_place(const glb_mesh *mesh) {
+    const uint8_t *p = mesh->position.data;
+    uint32_t stride = sizeof(object_vertex);
+
+    return mesh->position.stride == stride &&
+           mesh->normal.data == p + offsetof(object_vertex, normal) &&
+           mesh->normal.stride == stride &&
+           mesh->texture.data == p + offsetof(object_vertex, texture) &&
+           mesh->texture.stride == stride &&
+           mesh->indices != NULL && mesh->index_size == sizeof(uint32_t) &&
+           (uintptr_t)p % sizeof(float) == 0 &&
+           (uintptr_t)mesh->indices % sizeof(uint32_t) == 0;
+}
+
+void glb_copy(const glb_mesh *mesh, object_vertex *vertices,
+              object_face *faces) {
+    for (uint32_t i = 0; i < mesh->vertex_count; ++i) {
+        object_vertex *v = &vertices[i];
+        *v = (object_vertex){0};
+
+        memcpy(&v->position,
+               mesh->position.data + (size_t)i * mesh->position.stride,
+               sizeof(v->position));
+        if (mesh->normal.data != NULL) {
+            memcpy(&v->normal,
+                   mesh->normal.data + (size_t)i * mesh->normal.stride,
+                   sizeof(v->normal));
+        }
+        if (mesh->texture.data != NULL) {
+            memcpy(&v->texture,
+                   mesh->texture.data + (size_t)i * mesh->texture.stride,
+                   sizeof(v->texture));
+            v->texture.y = 1 - v->texture.y;
+        }
+    }
+
+    for (uint32_t k = 0; k < mesh->face_count; ++k) {
+        for (uint32_t h = 0; h < 3; ++h) {
+            faces[k].vertex_idxs[h] =
+                mesh->indices != NULL ? glb_index(mesh, 3 * k + h) : 3 * k + h;
+        }
+    }
+}
+
+void glb_flip_textures(object_vertex *vertices, uint32_t vertex_count) {
+    for (uint32_t i = 0; i < vertex_count; ++i) {
+        vertices[i].texture.y = 1 - vertices[i].texture.y;
+    }
+}
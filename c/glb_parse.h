@@ -0,0 +1,60 @@
+#ifndef GLB_PARSE_H
+#define GLB_PARSE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "obj.h"
+
+// gltf 2.0 binary: a 12 byte header, a json chunk describing the scene and
+// a binary chunk holding the buffers, little endian. only the first
+// primitive of the first mesh is read, which has to be triangles with
+// float POSITION and optionally float NORMAL and TEXCOORD_0 attributes,
+// and 8, 16 or 32 bit indices. node transforms are ignored, the object is
+// placed like any other. only the json is walked, for the few values
+// locating the buffers, which are never parsed, only copied or used in
+// place. nothing here allocates
+#define GLB_MAGIC 0x46546c67  // "glTF"
+#define GLB_VERSION 2
+
+// one attribute in the binary chunk, data is NULL when the primitive does
+// not have it
+typedef struct {
+    uint8_t *data;
+    uint32_t stride;  // bytes from one element to the next
+} glb_attribute;
+
+typedef struct {
+    uint32_t vertex_count;
+    uint32_t face_count;
+
+    glb_attribute position;
+    glb_attribute normal;
+    glb_attribute texture;
+
+    // NULL when every three vertices are a face
+    uint8_t *indices;
+    uint32_t index_size;
+} glb_mesh;
+
+// finds the mesh in the file. false when it is not a glb file, has no mesh
+// of the kind above, or an attribute or index is out of bounds
+bool glb_read(uint8_t *bytes, size_t size, glb_mesh *mesh);
+
+// true when the buffers are already laid out as object_vertex and
+// object_face arrays: the three attributes interleaved in that order and
+// 32 bit indices. the object can then point into the file instead of
+// copying it, after glb_flip_textures
+bool glb_in_place(const glb_mesh *mesh);
+
+// copies the mesh into object arrays of its counts, textures flipped.
+// missing normals and texture coordinates are 0
+void glb_copy(const glb_mesh *mesh, object_vertex *vertices,
+              object_face *faces);
+
+// gltf puts texture coordinate 0, 0 at the top left of the image, obj and
+// the samplers at the bottom left
+void glb_flip_textures(object_vertex *vertices, uint32_t vertex_count);
+
+#endif  // GLB_PARSE_H
@@ -2,9 +2,16 @@
 #include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include "camera.h"
+#include "framebuffer.h"
+#include "glb.h"
+#include "mesh.h"
+#include "meshz.h"
 #include "obj.h"
+#include "obj_parse.h"
+#include "stl.h"
 #include "texture.h"
 #include "vec3.h"
 
@@ -12,45 +19,132 @@
 #include "stb_image_write.h"
 
 void rasterize(uint8_t *image_buffer, uint32_t image_width,
-               uint32_t image_height, uint32_t image_channels) {
-    OBJ head_obj = OBJ_read_file("diablo3_pose.obj");
-    OBJ_position_and_scale(&head_obj, (point3){0, 0, -3}, (vec3){0, 45, 0},
+               uint32_t image_height, uint32_t image_channels,
+               const char *model_filepath, bool quantize,
+               uint32_t depth_format, bool prepass) {
+    // baked meshes and glb files are mapped, obj and stl files parsed and
+    // meshz files decoded
+    size_t n = strlen(model_filepath);
+    bool baked = n >= 5 && strcmp(model_filepath + n - 5, ".mesh") == 0;
+    bool glb = n >= 4 && strcmp(model_filepath + n - 4, ".glb") == 0;
+    bool stl = n >= 4 && strcmp(model_filepath + n - 4, ".stl") == 0;
+    bool meshz = n >= 6 && strcmp(model_filepath + n - 6, ".meshz") == 0;
+
+    mesh_file mesh = {0};
+    glb_file glb_model = {0};
+    object head_obj;
+    if (baked) {
+        mesh = mesh_open(model_filepath);
+        head_obj = mesh.obj;
+    } else if (glb) {
+        glb_model = glb_open(model_filepath);
+        head_obj = glb_model.obj;
+    } else if (stl) {
+        head_obj = STL_read_file(model_filepath);
+    } else if (meshz) {
+        head_obj = meshz_read_file(model_filepath);
+    } else {
+        head_obj = OBJ_read_file(model_filepath);
+    }
+    position_and_scale_obj(&head_obj, (point3){0, 0, -3}, (vec3){0, 45, 0},
                            1.0);
 
+    // drawn from a quantized copy, the float object is kept to be freed
+    object float_obj = head_obj;
+    if (quantize) {
+        head_obj = obj_quantize(
+            &float_obj, malloc(obj_quantized_size(float_obj.vertex_count,
+                                                  float_obj.face_count)));
+    }
+
     camera cam = {0};
     /* cam.image_width = image_width; */
     /* cam._image_height = image_height; */
     /**/
     /* cam.vfov = 80; */
-    cam.look_from = (point3){0, 0, 0};
-    cam.look_at = (point3){0, 0, -1.0};
-    cam.vup = (vec3){0, 1, 0};
+    look_at[2] = -1.0;
+    vup[1] = 1;
 
-    camera_initialize(&cam, image_width, image_height, image_channels, 20);
+    // the camera is at z 0 looking down -z, the model at -3
+    camera_initialize(&cam, image_width, image_height, image_channels, 20, 0,
+                      10);
 
-    float *z_buffer =
-        (float *)malloc(image_width * image_height * sizeof(float));
-    for (int i = 0; i < image_height * image_width; ++i) {
-        z_buffer[i] = -INFINITY;
-    }
+    uint32_t tiles_x =
+        (image_width + FRAMEBUFFER_TILE_SIZE - 1) / FRAMEBUFFER_TILE_SIZE;
+    uint32_t tiles_y =
+        (image_height + FRAMEBUFFER_TILE_SIZE - 1) / FRAMEBUFFER_TILE_SIZE;
 
-    texture_image ti = read_texture_image_png("diablo3_pose_diffuse.png");
+    framebuffer fb = {
+        .width = image_width,
+        .height = image_height,
+        .channels = image_channels,
+        .tiles_x = tiles_x,
+        .tiles_y = tiles_y,
+        .image = image_buffer,
+        .z_buffer = malloc(image_width * image_height *
+                           framebuffer_depth_size(depth_format)),
+        .tile_cleared = (uint8_t *)malloc(tiles_x * tiles_y),
+        .samples = 1,
+        .depth_format = depth_format,
+    };
 
-    rasterize_obj(image_buffer, &cam, &head_obj, &ti, z_buffer);
+    texture_image ti = read_texture_image_png("img/diablo3_pose_diffuse.png");
 
-    free(z_buffer);
-    OBJ_destroy(&head_obj);
+    framebuffer_clear(&fb);
+    if (prepass) {
+        rasterize_obj_depth(&fb, &cam, &head_obj);
+    }
+    rasterize_obj(&fb, &cam, &head_obj, &ti);
+    framebuffer_resolve(&fb);
+
+    free(fb.z_buffer);
+    free(fb.tile_cleared);
+    if (quantize) {
+        free(head_obj.arena);
+    }
+    if (baked) {
+        mesh_close(&mesh);
+    } else if (glb) {
+        glb_close(&glb_model);
+    } else {
+        OBJ_destroy(&float_obj);
+    }
     destroy_texture(&ti);
 }
 
-int main() {
+// ./main [-q] [-z16|-z24] [-p] [model.obj|.stl|.glb|.mesh|.meshz]
+//
+// -q draws the model quantized, see obj_quantize in obj_parse.h
+// -z16 and -z24 keep 16 or 24 bit integer depth, see framebuffer.h
+// -p draws depth alone first, see rasterize_obj_depth in camera.h
+int main(int argc, char **argv) {
+    bool quantize = false;
+    uint32_t depth_format = DEPTH_FLOAT32;
+    bool prepass = false;
+    for (; argc > 1 && argv[1][0] == '-'; --argc, ++argv) {
+        if (strcmp(argv[1], "-q") == 0) {
+            quantize = true;
+        } else if (strcmp(argv[1], "-z16") == 0) {
+            depth_format = DEPTH_UNORM16;
+        } else if (strcmp(argv[1], "-z24") == 0) {
+            depth_format = DEPTH_UNORM24;
+        } else if (strcmp(argv[1], "-p") == 0) {
+            prepass = true;
+        } else {
+            fprintf(stderr, "unknown option %s\n", argv[1]);
+            return 1;
+        }
+    }
+
     const uint32_t image_width = 400;
     const uint32_t image_height = 400;
     const uint32_t image_channels = 4;
 
     uint8_t *image_buffer = (uint8_t *)malloc(image_width * image_height * 4);
 
-    rasterize(image_buffer, image_width, image_height, image_channels);
+    rasterize(image_buffer, image_width, image_height, image_channels,
+              argc > 1 ? argv[1] : "3d/diablo3_pose.obj", quantize,
+              depth_format, prepass);
 
     if (stbi_write_png("img.png", image_width, image_height, image_channels,
                        image_buffer, image_width * image_channels)) {
@@ -0,0 +1,138 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include "mesh.h"
+
+#include <fcntl.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "obj_parse.h"
+
+static uint32_t align_up(uint32_t n) {
+    return (n + MESH_ALIGNMENT - 1) & ~(uint32_t)(MESH_ALIGNMENT - 1);
+}
+
+mesh_header mesh_layout(uint32_t vertex_count, uint32_t face_count) {
+    mesh_header h = {
+        .magic = MESH_MAGIC,
+        .version = MESH_VERSION,
+
+        .vertex_count = vertex_count,
+        .face_count = face_count,
+    };
+
+    h.vertices = align_up(sizeof(mesh_header));
+    h.faces = align_up(h.vertices + vertex_count * sizeof(object_vertex));
+    h.size = align_up(h.faces + face_count * sizeof(object_face));
+    return h;
+}
+
+void mesh_write_file(const char *mesh_filepath, const object *obj) {
+    mesh_header h = mesh_layout(obj->vertex_count, obj->face_count);
+    h.flags = obj->textured ? MESH_TEXTURED : 0;
+
+    uint8_t *bytes = (uint8_t *)calloc(h.size, 1);
+    if (bytes == NULL) {
+        fprintf(stderr, "error malloc mesh\n");
+        exit(1);
+    }
+
+    memcpy(bytes, &h, sizeof(h));
+    memcpy(bytes + h.vertices, obj->vertices,
+           obj->vertex_count * sizeof(object_vertex));
+    memcpy(bytes + h.faces, obj->faces, obj->face_count * sizeof(object_face));
+
+    FILE *mesh_file = fopen(mesh_filepath, "wb");
+    if (mesh_file == NULL) {
+        fprintf(stderr, "error opening mesh file: %s\n", mesh_filepath);
+        exit(1);
+    }
+    if (fwrite(bytes, 1, h.size, mesh_file) != h.size ||
+        fclose(mesh_file) != 0) {
+        fprintf(stderr, "error writing mesh file: %s\n", mesh_filepath);
+        exit(1);
+    }
+
+    free(bytes);
+}
+
+// the offsets have to be where this build would put them, which also
+// bounds them by the file size. with every count below 4 GB / the largest
+// element an overflowing layout shows up as offsets going backwards
+static bool mesh_valid(const mesh_header *h, size_t file_size) {
+    uint32_t max_count = UINT32_MAX / sizeof(object_vertex);
+    if (h->magic != MESH_MAGIC || h->version != MESH_VERSION ||
+        (h->flags & ~MESH_TEXTURED) != 0 || h->vertex_count > max_count ||
+        h->face_count > max_count) {
+        return false;
+    }
+
+    mesh_header expected = mesh_layout(h->vertex_count, h->face_count);
+    expected.flags = h->flags;
+    return memcmp(h, &expected, sizeof(expected)) == 0 &&
+           h->vertices <= h->faces && h->faces <= h->size &&
+           h->size <= file_size;
+}
+
+mesh_file mesh_open(const char *mesh_filepath) {
+    int fd = open(mesh_filepath, O_RDONLY);
+    if (fd < 0) {
+        fprintf(stderr, "error reading mesh file: %s\n", mesh_filepath);
+        exit(1);
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(mesh_header)) {
+        close(fd);
+        fprintf(stderr, "error mesh file too short: %s\n", mesh_filepath);
+        exit(1);
+    }
+
+    // writable but private, nothing is written back to the file
+    size_t map_size = st.st_size;
+    uint8_t *map = (uint8_t *)mmap(NULL, map_size, PROT_READ | PROT_WRITE,
+                                   MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) {
+        fprintf(stderr, "error mapping mesh file: %s\n", mesh_filepath);
+        exit(1);
+    }
+
+    mesh_header h;
+    memcpy(&h, map, sizeof(h));
+
+    if (!mesh_valid(&h, map_size)) {
+        munmap(map, map_size);
+        fprintf(stderr, "error invalid mesh file: %s\n", mesh_filepath);
+        exit(1);
+    }
+
+    void *cache = malloc(obj_cache_size(h.vertex_count, h.face_count));
+    if (cache == NULL) {
+        munmap(map, map_size);
+        fprintf(stderr, "error malloc mesh arena\n");
+        exit(1);
+    }
+
+    mesh_file mesh = {
+        .obj = obj_from_arrays((object_vertex *)(map + h.vertices),
+                               (object_face *)(map + h.faces), h.vertex_count,
+                               h.face_count, cache),
+
+        .map = map,
+        .map_size = map_size,
+    };
+    mesh.obj.textured = (h.flags & MESH_TEXTURED) != 0;
+    return mesh;
+}
+
+void mesh_close(mesh_file *mesh) {
+    free(mesh->obj.arena);
+    munmap(mesh->map, mesh->map_size);
+    *mesh = (mesh_file){0};
+}
@@ -0,0 +1,52 @@
+#ifndef MESH_H
+#define MESH_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "obj.h"
+
+// baked meshes: a header followed by the welded vertices and the faces of
+// an object, laid out as in memory so loading them is a mapping, not a
+// parse. little endian
+#define MESH_MAGIC 0x4853454d  // "MESH"
+#define MESH_VERSION 2
+#define MESH_ALIGNMENT 16
+
+// header flags
+#define MESH_TEXTURED (1u << 0)  // the vertices have texture coordinates
+
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t size;   // bytes in the file
+    uint32_t flags;  // MESH_TEXTURED or 0
+
+    uint32_t vertex_count;
+    uint32_t face_count;
+
+    // byte offsets from the start of the file, MESH_ALIGNMENT aligned
+    uint32_t vertices;
+    uint32_t faces;
+} mesh_header;
+
+// a baked mesh mapped into memory. the object arrays point into the
+// mapping, which is private so transforming the object copies only the
+// pages it writes. the screen space cache is the only allocation
+typedef struct {
+    object obj;
+
+    void *map;
+    size_t map_size;
+} mesh_file;
+
+// header of the file a mesh with these counts bakes to
+mesh_header mesh_layout(uint32_t vertex_count, uint32_t face_count);
+
+void mesh_write_file(const char *mesh_filepath, const object *obj);
+
+mesh_file mesh_open(const char *mesh_filepath);
+
+void mesh_close(mesh_file *mesh);
+
+#endif  // MESH_H
@@ -0,0 +1,418 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include "meshz.h"
+
+#include <fcntl.h>
+#include <math.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "camera.h"
+#include "meshz_parse.h"
+#include "obj_parse.h"
+
+#define MESHZ_COMPONENTS 7
+
+static void *meshz_malloc(size_t n) {
+    void *p = malloc(n);
+    if (p == NULL) {
+        fprintf(stderr, "error malloc meshz\n");
+        exit(1);
+    }
+    return p;
+}
+
+// order[i] is the vertex that becomes vertex i: the vertices in the order
+// the faces first use them, so a face's new vertex is always the next one,
+// and the unused ones after them
+static uint32_t *first_use_order(const object *obj, uint32_t *remap) {
+    uint32_t *order =
+        (uint32_t *)meshz_malloc(obj->vertex_count * sizeof(uint32_t));
+    memset(remap, 0xff, obj->vertex_count * sizeof(uint32_t));
+
+    uint32_t n = 0;
+    for (uint32_t i = 0; i < obj->face_count; ++i) {
+        for (int k = 0; k < 3; ++k) {
+            uint32_t v = obj->faces[i].vertex_idxs[k];
+            if (v >= obj->vertex_count) {
+                fprintf(stderr, "error face %u out of range\n", i);
+                exit(1);
+            }
+            if (remap[v] == UINT32_MAX) {
+                remap[v] = n;
+                order[n++] = v;
+            }
+        }
+    }
+    for (uint32_t v = 0; v < obj->vertex_count; ++v) {
+        if (remap[v] == UINT32_MAX) {
+            remap[v] = n;
+            order[n++] = v;
+        }
+    }
+    return order;
+}
+
+// the components of a vertex before quantizing, normals already
+// octahedral
+static void vertex_components(const object_vertex *v, float *out) {
+    vec2 n = vec3_to_octahedral(v->normal);
+    out[0] = v->position.x;
+    out[1] = v->position.y;
+    out[2] = v->position.z;
+    out[3] = n.x;
+    out[4] = n.y;
+    out[5] = v->texture.x;
+    out[6] = v->texture.y;
+}
+
+static uint16_t quantize(float x, float min, float scale, uint32_t max) {
+    if (scale == 0) {
+        return 0;
+    }
+    float q = (x - min) / scale + 0.5f;
+    return q <= 0 ? 0 : q >= max ? max : (uint16_t)q;
+}
+
+// zigzagged differences of the block's values from the ones before them,
+// packed to the width of the widest, lowest bits first
+static uint8_t *pack_block(uint8_t *p, const uint16_t *values,
+                           uint16_t *last) {
+    uint32_t zigzags[MESHZ_BLOCK_SIZE];
+    uint32_t all = 0;
+    for (int i = 0; i < MESHZ_BLOCK_SIZE; ++i) {
+        int16_t d = (int16_t)(uint16_t)(values[i] - *last);
+        zigzags[i] = (uint16_t)(((uint32_t)d << 1) ^ (uint32_t)(d >> 15));
+        all |= zigzags[i];
+        *last = values[i];
+    }
+
+    uint32_t width = 0;
+    while (all >> width) {
+        ++width;
+    }
+    *p++ = width;
+
+    uint32_t bits = 0, have = 0;
+    for (int i = 0; i < MESHZ_BLOCK_SIZE; ++i) {
+        bits |= zigzags[i] << have;
+        have += width;
+        while (have >= 8) {
+            *p++ = bits;
+            bits >>= 8;
+            have -= 8;
+        }
+    }
+    return p;
+}
+
+static uint8_t *encode_vertices(uint8_t *p, meshz_header *h,
+                                const object *obj, const uint32_t *order) {
+    uint32_t vertex_count = obj->vertex_count;
+
+    // the file only has the normals some vertex has, and texture
+    // coordinates when the object is textured
+    float min[MESHZ_COMPONENTS], max[MESHZ_COMPONENTS];
+    for (int c = 0; c < MESHZ_COMPONENTS; ++c) {
+        min[c] = INFINITY;
+        max[c] = -INFINITY;
+    }
+    if (obj->textured) {
+        h->flags |= MESHZ_TEXTURES;
+    }
+    for (uint32_t i = 0; i < vertex_count; ++i) {
+        const object_vertex *v = &obj->vertices[i];
+        if (v->normal.x != 0 || v->normal.y != 0 || v->normal.z != 0) {
+            h->flags |= MESHZ_NORMALS;
+        }
+
+        float x[MESHZ_COMPONENTS];
+        vertex_components(v, x);
+        for (int c = 0; c < MESHZ_COMPONENTS; ++c) {
+            min[c] = fminf(min[c], x[c]);
+            max[c] = fmaxf(max[c], x[c]);
+        }
+    }
+
+    // quantized components c of the file map to components of the vertex
+    int map[MESHZ_COMPONENTS] = {0, 1, 2};
+    uint32_t bits[MESHZ_COMPONENTS] = {h->position_bits, h->position_bits,
+                                       h->position_bits};
+    float q_min[MESHZ_COMPONENTS], q_scale[MESHZ_COMPONENTS];
+    uint32_t components = 3;
+    if (h->flags & MESHZ_NORMALS) {
+        map[components] = 3;
+        map[components + 1] = 4;
+        bits[components] = bits[components + 1] = h->normal_bits;
+        components += 2;
+    }
+    if (h->flags & MESHZ_TEXTURES) {
+        map[components] = 5;
+        map[components + 1] = 6;
+        bits[components] = bits[components + 1] = h->texture_bits;
+        components += 2;
+    }
+
+    for (uint32_t c = 0; c < components; ++c) {
+        int k = map[c];
+        uint32_t q_max = (1u << bits[c]) - 1;
+        if (k == 3 || k == 4) {
+            q_min[c] = -1;
+            q_scale[c] = 2.f / q_max;
+        } else if (vertex_count == 0) {
+            q_min[c] = 0;
+            q_scale[c] = 0;
+        } else {
+            q_min[c] = min[k];
+            q_scale[c] = (max[k] - min[k]) / q_max;
+        }
+    }
+    for (int a = 0; a < 3; ++a) {
+        h->position_min[a] = q_min[a];
+        h->position_scale[a] = q_scale[a];
+    }
+    if (h->flags & MESHZ_TEXTURES) {
+        for (int a = 0; a < 2; ++a) {
+            h->texture_min[a] = q_min[components - 2 + a];
+            h->texture_scale[a] = q_scale[components - 2 + a];
+        }
+    }
+
+    uint16_t last[MESHZ_COMPONENTS] = {0};
+    for (uint32_t first = 0; first < vertex_count; first += MESHZ_BLOCK_SIZE) {
+        // the last block is padded with copies of its last vertex, which
+        // cost nothing to store
+        uint16_t q[MESHZ_COMPONENTS][MESHZ_BLOCK_SIZE];
+        for (uint32_t i = 0; i < MESHZ_BLOCK_SIZE; ++i) {
+            uint32_t n =
+                first + i < vertex_count ? first + i : vertex_count - 1;
+
+            float x[MESHZ_COMPONENTS];
+            vertex_components(&obj->vertices[order[n]], x);
+            for (uint32_t c = 0; c < components; ++c) {
+                q[c][i] = quantize(x[map[c]], q_min[c], q_scale[c],
+                                   (1u << bits[c]) - 1);
+            }
+        }
+        for (uint32_t c = 0; c < components; ++c) {
+            p = pack_block(p, q[c], &last[c]);
+        }
+    }
+    return p;
+}
+
+// the encoder's side of the fifos decode_faces keeps
+typedef struct {
+    uint32_t edges[MESHZ_FIFO_SIZE][2];
+    uint32_t edge_head;
+
+    uint32_t vertices[MESHZ_FIFO_SIZE];
+    uint32_t vertex_head;
+
+    uint32_t next;
+    uint32_t last;
+} face_fifos;
+
+static void push_edge(face_fifos *f, uint32_t a, uint32_t b) {
+    uint32_t *e = f->edges[f->edge_head++ & (MESHZ_FIFO_SIZE - 1)];
+    e[0] = a;
+    e[1] = b;
+}
+
+static void push_vertex(face_fifos *f, uint32_t v) {
+    f->vertices[f->vertex_head++ & (MESHZ_FIFO_SIZE - 1)] = v;
+}
+
+// how far back edge a, b is in the fifo, MESHZ_NO_EDGE when it is not
+static uint32_t find_edge(const face_fifos *f, uint32_t a, uint32_t b) {
+    for (uint32_t k = 0; k < MESHZ_NO_EDGE && k < f->edge_head; ++k) {
+        const uint32_t *e =
+            f->edges[(f->edge_head - 1 - k) & (MESHZ_FIFO_SIZE - 1)];
+        if (e[0] == a && e[1] == b) {
+            return k;
+        }
+    }
+    return MESHZ_NO_EDGE;
+}
+
+// the nibble coding v, writing its varint to *data if it needs one
+static uint32_t encode_vertex(face_fifos *f, uint32_t v, uint8_t **data) {
+    if (v == f->next) {
+        ++f->next;
+        push_vertex(f, v);
+        return MESHZ_NEXT;
+    }
+    for (uint32_t k = 1; k < MESHZ_EXPLICIT && k <= f->vertex_head; ++k) {
+        if (f->vertices[(f->vertex_head - k) & (MESHZ_FIFO_SIZE - 1)] == v) {
+            return k;
+        }
+    }
+
+    uint32_t d = v - f->last;
+    uint32_t zigzag = (d << 1) ^ (uint32_t)((int32_t)d >> 31);
+    uint8_t *p = *data;
+    while (zigzag >= 0x80) {
+        *p++ = (zigzag & 0x7f) | 0x80;
+        zigzag >>= 7;
+    }
+    *p++ = zigzag;
+    *data = p;
+
+    f->last = v;
+    push_vertex(f, v);
+    return MESHZ_EXPLICIT;
+}
+
+static uint8_t *encode_faces(uint8_t *p, const object *obj,
+                             const uint32_t *remap) {
+    face_fifos f = {0};
+
+    for (uint32_t i = 0; i < obj->face_count; ++i) {
+        const uint32_t *idxs = obj->faces[i].vertex_idxs;
+        uint32_t v[3] = {remap[idxs[0]], remap[idxs[1]], remap[idxs[2]]};
+
+        // the rotation of the face starting with the most recent edge
+        uint32_t best = MESHZ_NO_EDGE, rotation = 0;
+        for (uint32_t r = 0; r < 3; ++r) {
+            uint32_t k = find_edge(&f, v[r], v[(r + 1) % 3]);
+            if (k < best) {
+                best = k;
+                rotation = r;
+            }
+        }
+
+        // codes and varints go out in the order decode_faces reads them
+        uint8_t varints[3 * 5];
+        uint8_t *data = varints;
+        if (best != MESHZ_NO_EDGE) {
+            uint32_t a = v[rotation], b = v[(rotation + 1) % 3],
+                     c = v[(rotation + 2) % 3];
+            *p++ = best << 4 | encode_vertex(&f, c, &data);
+            push_edge(&f, c, b);
+            push_edge(&f, a, c);
+        } else {
+            uint32_t na = encode_vertex(&f, v[0], &data);
+            uint32_t nb = encode_vertex(&f, v[1], &data);
+            uint32_t nc = encode_vertex(&f, v[2], &data);
+            *p++ = MESHZ_NO_EDGE << 4 | na;
+            *p++ = nb << 4 | nc;
+            push_edge(&f, v[1], v[0]);
+            push_edge(&f, v[2], v[1]);
+            push_edge(&f, v[0], v[2]);
+        }
+        memcpy(p, varints, data - varints);
+        p += data - varints;
+    }
+    return p;
+}
+
+uint32_t meshz_write_file(const char *meshz_filepath, const object *obj) {
+    meshz_header h = {
+        .magic = MESHZ_MAGIC,
+        .version = MESHZ_VERSION,
+
+        .vertex_count = obj->vertex_count,
+        .face_count = obj->face_count,
+
+        .vertices = sizeof(meshz_header),
+
+        .position_bits = MESHZ_POSITION_BITS,
+        .normal_bits = MESHZ_NORMAL_BITS,
+        .texture_bits = MESHZ_TEXTURE_BITS,
+    };
+
+    // every component of every block at full width, every face at two
+    // codes and three varints
+    size_t blocks =
+        ((size_t)obj->vertex_count + MESHZ_BLOCK_SIZE - 1) / MESHZ_BLOCK_SIZE;
+    size_t bound = sizeof(meshz_header) +
+                   blocks * MESHZ_COMPONENTS * (1 + 2 * MESHZ_BLOCK_SIZE) +
+                   (size_t)obj->face_count * (2 + 3 * 5) + MESHZ_PADDING;
+    if (bound > UINT32_MAX) {
+        fprintf(stderr, "error object too large for meshz\n");
+        exit(1);
+    }
+    uint8_t *bytes = (uint8_t *)calloc(bound, 1);
+    if (bytes == NULL) {
+        fprintf(stderr, "error malloc meshz\n");
+        exit(1);
+    }
+
+    uint32_t *remap =
+        (uint32_t *)meshz_malloc(obj->vertex_count * sizeof(uint32_t));
+    uint32_t *order = first_use_order(obj, remap);
+
+    uint8_t *p = encode_vertices(bytes + h.vertices, &h, obj, order);
+    h.faces = p - bytes;
+    p = encode_faces(p, obj, remap);
+    h.size = p - bytes + MESHZ_PADDING;
+    memcpy(bytes, &h, sizeof(h));
+
+    free(order);
+    free(remap);
+
+    FILE *meshz_file = fopen(meshz_filepath, "wb");
+    if (meshz_file == NULL) {
+        fprintf(stderr, "error opening meshz file: %s\n", meshz_filepath);
+        exit(1);
+    }
+    if (fwrite(bytes, 1, h.size, meshz_file) != h.size ||
+        fclose(meshz_file) != 0) {
+        fprintf(stderr, "error writing meshz file: %s\n", meshz_filepath);
+        exit(1);
+    }
+
+    free(bytes);
+    return h.size;
+}
+
+object meshz_read_file(const char *meshz_filepath) {
+    int fd = open(meshz_filepath, O_RDONLY);
+    struct stat st;
+    if (fd < 0 || fstat(fd, &st) != 0 || st.st_size == 0) {
+        fprintf(stderr, "error reading meshz file: %s\n", meshz_filepath);
+        exit(1);
+    }
+
+    size_t map_size = st.st_size;
+    uint8_t *map =
+        (uint8_t *)mmap(NULL, map_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) {
+        fprintf(stderr, "error mapping meshz file: %s\n", meshz_filepath);
+        exit(1);
+    }
+
+    meshz_header h;
+    if (!meshz_read_header(map, map_size, &h)) {
+        munmap(map, map_size);
+        fprintf(stderr, "error invalid meshz file: %s\n", meshz_filepath);
+        exit(1);
+    }
+
+    void *arena = malloc(obj_arena_size(h.vertex_count, h.face_count));
+    if (arena == NULL) {
+        munmap(map, map_size);
+        fprintf(stderr, "error malloc meshz arena\n");
+        exit(1);
+    }
+
+    object obj = obj_from_arena(arena, h.vertex_count, h.face_count);
+    bool decoded = meshz_decode(map, &h, obj.vertices, obj.faces);
+    munmap(map, map_size);
+    if (!decoded) {
+        fprintf(stderr, "error corrupt meshz file: %s\n", meshz_filepath);
+        exit(1);
+    }
+
+    if ((h.flags & MESHZ_NORMALS) == 0) {
+        obj.shading = SHADING_FLAT;
+    }
+    obj.textured = (h.flags & MESHZ_TEXTURES) != 0;
+    return obj;
+}
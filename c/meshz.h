@@ -0,0 +1,22 @@
+#ifndef MESHZ_H
+#define MESHZ_H
+
+#include "obj.h"
+
+// bits the encoder quantizes to. 16 bit positions are within 1 / 65535 of
+// the extent, 10 bit octahedral normals within half a degree and 12 bit
+// texture coordinates within a quarter texel of a 1024 texture
+#define MESHZ_POSITION_BITS 16
+#define MESHZ_NORMAL_BITS 10
+#define MESHZ_TEXTURE_BITS 12
+
+// compresses the object into a meshz file, see meshz_parse.h. its
+// vertices are reordered and its faces rotated, the mesh is the same.
+// returns the size of the file
+uint32_t meshz_write_file(const char *meshz_filepath, const object *obj);
+
+// reads a meshz file into an object, free it with OBJ_destroy. flat shaded
+// when the file has no normals
+object meshz_read_file(const char *meshz_filepath);
+
+#endif  // MESHZ_H
@@ -0,0 +1,277 @@
+#include "meshz_parse.h"
+
+#include <string.h>
+
+// most components a vertex has, three of the position, two each of the
+// normal and texture coordinates
+#define MESHZ_COMPONENTS 7
+
+// largest block of one component, its width and 16 differences of 16 bits,
+// and the bytes unpack_block reads past it
+#define MESHZ_PACKED_SIZE (1 + 2 * MESHZ_BLOCK_SIZE)
+#define MESHZ_OVERREAD 3
+
+// largest face, two code bytes and three varints
+#define MESHZ_FACE_SIZE (2 + 3 * 5)
+
+static uint32_t component_count(uint32_t flags) {
+    return 3 + ((flags & MESHZ_NORMALS) ? 2 : 0) +
+           ((flags & MESHZ_TEXTURES) ? 2 : 0);
+}
+
+bool meshz_read_header(const uint8_t *bytes, size_t size, meshz_header *h) {
+    if (size < sizeof(meshz_header)) {
+        return false;
+    }
+    memcpy(h, bytes, sizeof(meshz_header));
+
+    if (h->magic != MESHZ_MAGIC || h->version != MESHZ_VERSION ||
+        (h->flags & ~(uint32_t)(MESHZ_NORMALS | MESHZ_TEXTURES)) != 0 ||
+        h->position_bits == 0 || h->position_bits > 16 ||
+        h->normal_bits > 16 || h->texture_bits > 16 || h->reserved != 0) {
+        return false;
+    }
+    if ((h->flags & MESHZ_NORMALS) && h->normal_bits < 2) {
+        return false;
+    }
+    if ((h->flags & MESHZ_TEXTURES) && h->texture_bits == 0) {
+        return false;
+    }
+
+    if (h->size > size || h->vertices != sizeof(meshz_header) ||
+        h->faces < h->vertices || h->size < MESHZ_PADDING ||
+        h->faces > h->size - MESHZ_PADDING) {
+        return false;
+    }
+
+    // every block takes a byte per component and every face a byte, which
+    // bounds the counts and so the arrays they are decoded into by the
+    // size of the file
+    uint64_t blocks =
+        ((uint64_t)h->vertex_count + MESHZ_BLOCK_SIZE - 1) / MESHZ_BLOCK_SIZE;
+    return blocks * component_count(h->flags) <= h->faces - h->vertices &&
+           h->face_count <= h->size - MESHZ_PADDING - h->faces &&
+           (h->vertex_count > 0 || h->face_count == 0);
+}
+
+static uint32_t read_u32(const uint8_t *p) {
+    uint32_t v;
+    memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+// width of the block and its 16 differences packed to it, lowest bits
+// first. undoes the zigzag and adds each difference to the value before,
+// which starts at *last. NULL when the width is out of range
+static const uint8_t *unpack_block(const uint8_t *p, uint16_t *last,
+                                   uint16_t *out) {
+    uint32_t width = *p++;
+    if (width > 16) {
+        return NULL;
+    }
+
+    // a difference is at most 16 bits 7 bits into its first byte, one load
+    // reaches all of it. the last ones read up to 3 bytes past the block
+    uint32_t mask = (1u << width) - 1;
+    uint16_t value = *last;
+    for (uint32_t i = 0; i < MESHZ_BLOCK_SIZE; ++i) {
+        uint32_t bit = i * width;
+        uint32_t zigzag = (read_u32(p + (bit >> 3)) >> (bit & 7)) & mask;
+        value += (uint16_t)((zigzag >> 1) ^ -(zigzag & 1));
+        out[i] = value;
+    }
+    *last = value;
+    return p + 2 * width;
+}
+
+static bool decode_vertices(const uint8_t *bytes, const meshz_header *h,
+                            object_vertex *vertices) {
+    const uint8_t *p = bytes + h->vertices;
+    const uint8_t *end = bytes + h->size;
+
+    bool normals = h->flags & MESHZ_NORMALS;
+    bool textures = h->flags & MESHZ_TEXTURES;
+    uint32_t components = component_count(h->flags);
+
+    float normal_scale = 2.f / ((1u << h->normal_bits) - 1);
+
+    uint16_t last[MESHZ_COMPONENTS] = {0};
+    uint16_t q[MESHZ_COMPONENTS][MESHZ_BLOCK_SIZE];
+
+    for (uint32_t first = 0; first < h->vertex_count;
+         first += MESHZ_BLOCK_SIZE) {
+        size_t block_size = components * MESHZ_PACKED_SIZE + MESHZ_OVERREAD;
+        if ((size_t)(end - p) < block_size) {
+            return false;
+        }
+        for (uint32_t c = 0; c < components; ++c) {
+            p = unpack_block(p, &last[c], q[c]);
+            if (p == NULL) {
+                return false;
+            }
+        }
+
+        uint32_t n = h->vertex_count - first;
+        if (n > MESHZ_BLOCK_SIZE) {
+            n = MESHZ_BLOCK_SIZE;
+        }
+
+        object_vertex *out = vertices + first;
+        for (uint32_t i = 0; i < n; ++i) {
+            out[i].position = (point3){
+                h->position_min[0] + q[0][i] * h->position_scale[0],
+                h->position_min[1] + q[1][i] * h->position_scale[1],
+                h->position_min[2] + q[2][i] * h->position_scale[2],
+            };
+        }
+
+        uint32_t c = 3;
+        if (normals) {
+            for (uint32_t i = 0; i < n; ++i) {
+                out[i].normal =
+                    octahedral_to_vec3(q[c][i] * normal_scale - 1,
+                                       q[c + 1][i] * normal_scale - 1);
+            }
+            c += 2;
+        } else {
+            for (uint32_t i = 0; i < n; ++i) {
+                out[i].normal = (point3){0, 0, 0};
+            }
+        }
+
+        if (textures) {
+            for (uint32_t i = 0; i < n; ++i) {
+                out[i].texture = (vec2){
+                    h->texture_min[0] + q[c][i] * h->texture_scale[0],
+                    h->texture_min[1] + q[c + 1][i] * h->texture_scale[1],
+                };
+            }
+        } else {
+            for (uint32_t i = 0; i < n; ++i) {
+                out[i].texture = (vec2){0, 0};
+            }
+        }
+    }
+
+    return p == bytes + h->faces;
+}
+
+// the fifos, each entry pushed at head & 15 so index 1 back is the latest
+typedef struct {
+    uint32_t edges[MESHZ_FIFO_SIZE][2];
+    uint32_t edge_head;
+
+    uint32_t vertices[MESHZ_FIFO_SIZE];
+    uint32_t vertex_head;
+
+    uint32_t next;  // the next vertex not used yet
+    uint32_t last;  // the last explicit vertex
+} face_fifos;
+
+static void push_edge(face_fifos *f, uint32_t a, uint32_t b) {
+    uint32_t *e = f->edges[f->edge_head++ & (MESHZ_FIFO_SIZE - 1)];
+    e[0] = a;
+    e[1] = b;
+}
+
+static void push_vertex(face_fifos *f, uint32_t v) {
+    f->vertices[f->vertex_head++ & (MESHZ_FIFO_SIZE - 1)] = v;
+}
+
+// the vertex a nibble codes, advancing p past its varint if it has one.
+// false when the vertex is out of range
+static bool decode_vertex(face_fifos *f, uint32_t nibble, const uint8_t **p,
+                          uint32_t vertex_count, uint32_t *v) {
+    if (nibble == MESHZ_NEXT) {
+        if (f->next >= vertex_count) {
+            return false;
+        }
+        *v = f->next++;
+        push_vertex(f, *v);
+        return true;
+    }
+    if (nibble != MESHZ_EXPLICIT) {
+        *v = f->vertices[(f->vertex_head - nibble) & (MESHZ_FIFO_SIZE - 1)];
+        return true;
+    }
+
+    const uint8_t *q = *p;
+    uint32_t zigzag = 0;
+    for (uint32_t shift = 0;; shift += 7) {
+        if (shift == 35) {
+            return false;
+        }
+        uint8_t byte = *q++;
+        zigzag |= (uint32_t)(byte & 0x7f) << shift;
+        if ((byte & 0x80) == 0) {
+            break;
+        }
+    }
+    *p = q;
+
+    *v = f->last + ((zigzag >> 1) ^ -(zigzag & 1));
+    if (*v >= vertex_count) {
+        return false;
+    }
+    f->last = *v;
+    push_vertex(f, *v);
+    return true;
+}
+
+static bool decode_faces(const uint8_t *bytes, const meshz_header *h,
+                         object_face *faces) {
+    const uint8_t *p = bytes + h->faces;
+    const uint8_t *end = bytes + h->size;
+    uint32_t vertex_count = h->vertex_count;
+
+    face_fifos f = {0};
+
+    for (uint32_t i = 0; i < h->face_count; ++i) {
+        if (end - p < MESHZ_FACE_SIZE) {
+            return false;
+        }
+        uint32_t code = *p++;
+        uint32_t *idxs = faces[i].vertex_idxs;
+
+        if ((code >> 4) != MESHZ_NO_EDGE) {
+            // the face shares a, b with the one the edge came from, which
+            // went around it the other way
+            uint32_t back = code >> 4;
+            const uint32_t *e =
+                f.edges[(f.edge_head - 1 - back) & (MESHZ_FIFO_SIZE - 1)];
+            uint32_t a = e[0], b = e[1], c;
+            if (!decode_vertex(&f, code & 15, &p, vertex_count, &c)) {
+                return false;
+            }
+            push_edge(&f, c, b);
+            push_edge(&f, a, c);
+
+            idxs[0] = a;
+            idxs[1] = b;
+            idxs[2] = c;
+        } else {
+            uint32_t more = *p++;
+            uint32_t a, b, c;
+            if (!decode_vertex(&f, code & 15, &p, vertex_count, &a) ||
+                !decode_vertex(&f, more >> 4, &p, vertex_count, &b) ||
+                !decode_vertex(&f, more & 15, &p, vertex_count, &c)) {
+                return false;
+            }
+            push_edge(&f, b, a);
+            push_edge(&f, c, b);
+            push_edge(&f, a, c);
+
+            idxs[0] = a;
+            idxs[1] = b;
+            idxs[2] = c;
+        }
+    }
+
+    return p == end - MESHZ_PADDING;
+}
+
+bool meshz_decode(const uint8_t *bytes, const meshz_header *h,
+                  object_vertex *vertices, object_face *faces) {
+    return decode_vertices(bytes, h, vertices) &&
+           decode_faces(bytes, h, faces);
+}
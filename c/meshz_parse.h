@@ -0,0 +1,80 @@
+#ifndef MESHZ_PARSE_H
+#define MESHZ_PARSE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "obj.h"
+
+// compressed meshes, for sending over the wire: a header, the vertices and
+// then the faces, little endian. the vertices are quantized, positions and
+// texture coordinates to integers over their extent and normals to
+// octahedral coordinates, and ordered by first use in the faces. each
+// quantized component is stored as the difference from the previous
+// vertex's, zigzagged, in blocks of 16 vertices packed to the width of the
+// block's widest difference. the faces are coded against a fifo of recent
+// edges and one of recent vertices, most faces share an edge with one not
+// long before and take one byte. see meshz.c for the encoder. nothing here
+// allocates
+#define MESHZ_MAGIC 0x5a48534d  // "MSHZ"
+#define MESHZ_VERSION 1
+
+// flags, a component missing from the file decodes to 0
+#define MESHZ_NORMALS 1
+#define MESHZ_TEXTURES 2
+
+// vertices per block of the vertex stream
+#define MESHZ_BLOCK_SIZE 16
+
+// the encoder pads the file by this much so the decoder can check the
+// bounds of a whole block or face at once, at least the largest of either
+#define MESHZ_PADDING 256
+
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t size;  // bytes in the file, padding included
+    uint32_t flags;
+
+    uint32_t vertex_count;
+    uint32_t face_count;
+
+    // byte offsets from the start of the file
+    uint32_t vertices;
+    uint32_t faces;
+
+    // bits of each quantized component, at most 16
+    uint8_t position_bits;
+    uint8_t normal_bits;
+    uint8_t texture_bits;
+    uint8_t reserved;
+
+    // a quantized component q decodes to min + q * scale
+    float position_min[3];
+    float position_scale[3];
+    float texture_min[2];
+    float texture_scale[2];
+} meshz_header;
+
+// face codes: the high nibble is how far back in the edge fifo the edge
+// the face shares is, MESHZ_NO_EDGE when it shares none and a second byte
+// follows. a nibble coding a vertex is MESHZ_NEXT for the next vertex not
+// used yet, how far back in the vertex fifo it is from 1, or
+// MESHZ_EXPLICIT for an index stored as a zigzagged varint difference from
+// the last explicit one
+#define MESHZ_FIFO_SIZE 16
+#define MESHZ_NO_EDGE 15
+#define MESHZ_NEXT 0
+#define MESHZ_EXPLICIT 15
+
+// reads the header of the file. false when it is not a meshz file or its
+// sections are out of bounds
+bool meshz_read_header(const uint8_t *bytes, size_t size, meshz_header *h);
+
+// decodes the file into object arrays of the header's counts. false when
+// the streams are corrupt, out is then partly written
+bool meshz_decode(const uint8_t *bytes, const meshz_header *h,
+                  object_vertex *vertices, object_face *faces);
+
+#endif  // MESHZ_PARSE_H
@@ -0,0 +1,145 @@
+#include "mipmap.h"
+
+#include <math.h>
+
+static uint32_t level_count(int32_t width, int32_t height) {
+    uint32_t count = 1;
+    while ((width > 1 || height > 1) && count < TEXTURE_MAX_LEVELS) {
+        width = width > 1 ? width / 2 : 1;
+        height = height > 1 ? height / 2 : 1;
+        ++count;
+    }
+    return count;
+}
+
+static texture_level level_of_size(int32_t width, int32_t height,
+                                   uint32_t block_shift) {
+    uint32_t block_size = 1u << block_shift;
+    return (texture_level){
+        .width = width,
+        .height = height,
+        .blocks_x = (width + block_size - 1) >> block_shift,
+    };
+}
+
+// whole blocks, the padding texels repeat the last row / column
+static uint32_t level_texels(texture_level *level, uint32_t block_shift) {
+    uint32_t block_size = 1u << block_shift;
+    uint32_t blocks_y = (level->height + block_size - 1) >> block_shift;
+    return (level->blocks_x * blocks_y) << (2 * block_shift);
+}
+
+uint32_t texture_levels_size(texture_image *ti, uint32_t block_shift) {
+    uint32_t count = level_count(ti->image_width, ti->image_height);
+    uint32_t size = 0;
+
+    int32_t width = ti->image_width, height = ti->image_height;
+    for (uint32_t i = 0; i < count; ++i) {
+        texture_level level = level_of_size(width, height, block_shift);
+        size += level_texels(&level, block_shift) * ti->image_channels;
+
+        width = width > 1 ? width / 2 : 1;
+        height = height > 1 ? height / 2 : 1;
+    }
+    return size;
+}
+
+static void tile_image(texture_image *ti, texture_level *dst,
+                       uint32_t block_shift) {
+    int32_t channels = ti->image_channels;
+    uint32_t block_size = 1u << block_shift;
+    uint32_t rows = ((dst->height + block_size - 1) >> block_shift)
+                    << block_shift;
+    uint32_t cols = dst->blocks_x << block_shift;
+
+    for (uint32_t row = 0; row < rows; ++row) {
+        uint32_t src_row = row < dst->height ? row : dst->height - 1;
+        for (uint32_t col = 0; col < cols; ++col) {
+            uint32_t src_col = col < dst->width ? col : dst->width - 1;
+
+            const uint8_t *src =
+                ti->image + (src_row * ti->image_width + src_col) * channels;
+            uint8_t *out = dst->image +
+                           texel_offset(dst, block_shift, row, col) * channels;
+            for (int32_t c = 0; c < channels; ++c) {
+                out[c] = src[c];
+            }
+        }
+    }
+}
+
+static void downsample(const texture_level *src, texture_level *dst,
+                       uint32_t block_shift, int32_t channels) {
+    uint32_t block_size = 1u << block_shift;
+    uint32_t rows = ((dst->height + block_size - 1) >> block_shift)
+                    << block_shift;
+    uint32_t cols = dst->blocks_x << block_shift;
+
+    for (uint32_t row = 0; row < rows; ++row) {
+        // odd sizes and padding repeat the last row / column instead of
+        // reading past it
+        uint32_t y = row < dst->height ? row : dst->height - 1;
+        uint32_t y0 = 2 * y < src->height ? 2 * y : src->height - 1;
+        uint32_t y1 = y0 + 1 < src->height ? y0 + 1 : y0;
+
+        for (uint32_t col = 0; col < cols; ++col) {
+            uint32_t x = col < dst->width ? col : dst->width - 1;
+            uint32_t x0 = 2 * x < src->width ? 2 * x : src->width - 1;
+            uint32_t x1 = x0 + 1 < src->width ? x0 + 1 : x0;
+
+            const uint8_t *p00 =
+                src->image + texel_offset(src, block_shift, y0, x0) * channels;
+            const uint8_t *p01 =
+                src->image + texel_offset(src, block_shift, y0, x1) * channels;
+            const uint8_t *p10 =
+                src->image + texel_offset(src, block_shift, y1, x0) * channels;
+            const uint8_t *p11 =
+                src->image + texel_offset(src, block_shift, y1, x1) * channels;
+            uint8_t *out = dst->image +
+                           texel_offset(dst, block_shift, row, col) * channels;
+
+            for (int32_t c = 0; c < channels; ++c) {
+                uint32_t sum = p00[c] + p01[c] + p10[c] + p11[c];
+                out[c] = (sum + 2) / 4;
+            }
+        }
+    }
+}
+
+void texture_build_levels(texture_image *ti, uint32_t block_shift,
+                          uint8_t *storage) {
+    ti->block_shift = block_shift;
+    ti->level_count = level_count(ti->image_width, ti->image_height);
+
+    int32_t width = ti->image_width, height = ti->image_height;
+    for (uint32_t i = 0; i < ti->level_count; ++i) {
+        texture_level *dst = &ti->levels[i];
+
+        *dst = level_of_size(width, height, block_shift);
+        dst->image = storage;
+        storage += level_texels(dst, block_shift) * ti->image_channels;
+
+        if (i == 0) {
+            tile_image(ti, dst, block_shift);
+        } else {
+            downsample(&ti->levels[i - 1], dst, block_shift,
+                       ti->image_channels);
+        }
+
+        width = width > 1 ? width / 2 : 1;
+        height = height > 1 ? height / 2 : 1;
+    }
+}
+
+uint32_t texture_select_level(texture_image *ti, float uv_area,
+                              float pixel_area) {
+    float texel_area = uv_area * ti->image_width * ti->image_height;
+    if (ti->level_count < 2 || texel_area <= pixel_area || pixel_area <= 0) {
+        return 0;
+    }
+
+    // every level quarters the texel area
+    float lod = 0.5f * log2f(texel_area / pixel_area);
+    uint32_t level = lod;
+    return level < ti->level_count ? level : ti->level_count - 1;
+}
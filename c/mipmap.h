@@ -0,0 +1,22 @@
+#ifndef MIPMAP_H
+#define MIPMAP_H
+
+#include <stdint.h>
+
+#include "texture.h"
+
+// bytes needed for the whole chain stored in blocks of 1 << block_shift
+// texels per side
+uint32_t texture_levels_size(texture_image *ti, uint32_t block_shift);
+
+// copies the row major image into block layout as levels[0], then box
+// filters it down to 1x1. storage must hold texture_levels_size bytes
+void texture_build_levels(texture_image *ti, uint32_t block_shift,
+                          uint8_t *storage);
+
+// level whose texel density best matches a triangle covering uv_area of
+// the normalized texture and pixel_area pixels on screen
+uint32_t texture_select_level(texture_image *ti, float uv_area,
+                              float pixel_area);
+
+#endif  // MIPMAP_H
@@ -1,214 +1,248 @@
+#define _POSIX_C_SOURCE 200809L
+
 #include "obj.h"
 
 #include <assert.h>
+#include <fcntl.h>
 #include <float.h>
+#include <pthread.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
-#include <wasm_simd128.h>
-
-object OBJ_read_file(const char *obj_filepath) {
-    FILE *obj_file = fopen(obj_filepath, "r");
-    if (obj_file == NULL) {
-        fprintf(stderr, "error reading obj file: %s\n", obj_filepath);
-        exit(1);
-    }
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
-    uint32_t vertex_count = 0, vertex_texture_count = 0,
-             vertex_normal_count = 0, face_count = 0;
-
-#define BUFFER_SIZE 128
-    char buffer[BUFFER_SIZE];
-
-    while (fgets(buffer, BUFFER_SIZE, obj_file)) {
-        switch (buffer[0]) {
-            case 'v': {
-                switch (buffer[1]) {
-                    case ' ': {
-                        ++vertex_count;
-                    } break;
-                    case 't': {
-                        if (buffer[2] == ' ') {
-                            ++vertex_texture_count;
-                        }
-                    } break;
-                    case 'n': {
-                        if (buffer[2] == ' ') {
-                            ++vertex_normal_count;
-                        }
-                    } break;
-                }
-            } break;
-            case 'f': {
-                if (buffer[1] == ' ') {
-                    ++face_count;
-                }
-            } break;
-        }
-    }
+#include "obj_parse.h"
 
-    if (ferror(obj_file)) {
-        fclose(obj_file);
-        fprintf(stderr, "Error reading file\n");
-        exit(1);
-    }
+#define OBJ_MAX_THREADS 16
+// smaller chunks are not worth a thread
+#define OBJ_MIN_CHUNK_SIZE (1 << 20)
 
-    void *arena = malloc(vertex_count * sizeof(point3) +
-                         vertex_texture_count * sizeof(vec2) +
-                         vertex_normal_count * sizeof(point3) +
-                         face_count * sizeof(object_face));
+typedef struct {
+    const char *begin, *end;
 
-    if (arena == NULL) {
-        fclose(obj_file);
-        fprintf(stderr, "error malloc obj arena\n");
-        exit(1);
-    }
+    obj_counts counts;
+    obj_counts first;
+    obj_counts total;
 
-    point3 *vertices = (point3 *)arena;
+    const obj_sink *sink;
+    const char *error;
 
-    vec2 *vertex_textures = (vec2 *)(vertices + vertex_count);
+    pthread_t thread;
+} obj_chunk;
 
-    point3 *vertex_normals = (point3 *)(vertex_textures + vertex_texture_count);
+// a mapped obj file split into newline aligned chunks, one per thread
+typedef struct {
+    char *map;
+    size_t map_size;
 
-    object_face *faces = (object_face *)(vertex_normals + vertex_normal_count);
+    uint32_t chunk_count;
+    obj_chunk chunks[OBJ_MAX_THREADS];
 
-    if (fseek(obj_file, 0, SEEK_SET) != 0) {
-        fclose(obj_file);
-        fprintf(stderr, "error returning to start of file\n");
-        exit(1);
-    };
+    obj_counts total;
+} obj_text;
 
-    uint32_t v_idx = 0, vt_idx = 0, vn_idx = 0, f_idx = 0;
+static void *count_pass(void *arg) {
+    obj_chunk *chunk = (obj_chunk *)arg;
+    chunk->counts = obj_count_chunk(chunk->begin, chunk->end);
+    return NULL;
+}
 
-    float x, y, z, w;
-    uint32_t i, j, k;
+static void *parse_pass(void *arg) {
+    obj_chunk *chunk = (obj_chunk *)arg;
+    chunk->error = obj_parse_chunk(chunk->begin, chunk->end, chunk->first,
+                                   chunk->total, chunk->sink);
+    return NULL;
+}
 
-    while (fscanf(obj_file, "%s", buffer) != EOF) {
-        if (ferror(obj_file)) {
-            fclose(obj_file);
-            fprintf(stderr, "Error reading file\n");
+// the first chunk runs on the calling thread
+static void run_pass(obj_text *text, void *(*pass)(void *)) {
+    for (uint32_t i = 1; i < text->chunk_count; ++i) {
+        obj_chunk *chunk = &text->chunks[i];
+        if (pthread_create(&chunk->thread, NULL, pass, chunk) != 0) {
+            fprintf(stderr, "error starting obj parse thread\n");
             exit(1);
         }
-        if (strcmp(buffer, "v") == 0) {
-            if (fscanf(obj_file, "%f %f %f %f", &x, &y, &z, &w) < 3) {
-                fclose(obj_file);
-                fprintf(stderr, "error reading vertex\n");
-                exit(1);
-            }
-            vertices[v_idx] = (point3){x, y, z};
-            ++v_idx;
-            continue;
-        }
-        if (strcmp(buffer, "vt") == 0) {
-            if (fscanf(obj_file, "%f %f %f", &x, &y, &w) < 2) {
-                fclose(obj_file);
-                fprintf(stderr, "error reading vertex texture\n");
-                exit(1);
-            }
-            vertex_textures[vt_idx] = (vec2){x, y};
-            ++vt_idx;
-            continue;
+    }
+    if (text->chunk_count > 0) {
+        pass(&text->chunks[0]);
+    }
+    for (uint32_t i = 1; i < text->chunk_count; ++i) {
+        pthread_join(text->chunks[i].thread, NULL);
+    }
+}
+
+// maps the file, splits it and counts its elements
+static obj_text obj_text_open(const char *obj_filepath) {
+    int fd = open(obj_filepath, O_RDONLY);
+    struct stat st;
+    if (fd < 0 || fstat(fd, &st) != 0) {
+        fprintf(stderr, "error reading obj file: %s\n", obj_filepath);
+        exit(1);
+    }
+
+    obj_text text = {.map_size = st.st_size};
+    if (text.map_size > 0) {
+        text.map = (char *)mmap(NULL, text.map_size, PROT_READ, MAP_PRIVATE,
+                                fd, 0);
+        if (text.map == MAP_FAILED) {
+            close(fd);
+            fprintf(stderr, "error mapping obj file: %s\n", obj_filepath);
+            exit(1);
         }
-        if (strcmp(buffer, "vn") == 0) {
-            if (fscanf(obj_file, "%f %f %f", &x, &y, &z) < 3) {
-                fclose(obj_file);
-                fprintf(stderr, "error reading vertex normals\n");
-                exit(1);
-            }
-            vertex_normals[vn_idx] = (point3){x, y, z};
-            ++vn_idx;
-            continue;
+    }
+    close(fd);
+
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    size_t chunk_count = text.map_size / OBJ_MIN_CHUNK_SIZE;
+    if (chunk_count > (size_t)cpus) {
+        chunk_count = cpus;
+    }
+    if (chunk_count > OBJ_MAX_THREADS) {
+        chunk_count = OBJ_MAX_THREADS;
+    }
+    if (chunk_count < 1 && text.map_size > 0) {
+        chunk_count = 1;
+    }
+    text.chunk_count = chunk_count;
+
+    const char *end = text.map + text.map_size;
+    const char *begin = text.map;
+    for (uint32_t i = 0; i < text.chunk_count; ++i) {
+        const char *split =
+            i + 1 == text.chunk_count
+                ? end
+                : text.map + text.map_size / chunk_count * (i + 1);
+        if (split < begin) {
+            split = begin;
         }
-        if (strcmp(buffer, "f") == 0) {
-            for (int h = 0; h < 3; ++h) {
-                if (fscanf(obj_file, "%u/%u/%u", &i, &j, &k) != 3) {
-                    fclose(obj_file);
-                    fprintf(stderr,
-                            "error reading face, face must contain "
-                            "vertex/vertex_texture/vertex_normal x 3");
-                    exit(1);
-                };
-                faces[f_idx].vertex_idxs[h] = i - 1;
-                faces[f_idx].vertex_texture_idxs[h] = j - 1;
-                faces[f_idx].vertex_normal_idxs[h] = k - 1;
-            }
-            ++f_idx;
-            continue;
+        // move split to the start of a line
+        if (split > begin && split < end) {
+            split = obj_next_line(split - 1, end);
         }
+        text.chunks[i].begin = begin;
+        text.chunks[i].end = split;
+        begin = split;
     }
 
-    fclose(obj_file);
+    run_pass(&text, count_pass);
 
-    assert(vertex_count == vertex_normal_count);
+    // prefix sums, each chunk writes from the end of the ones before it
+    for (uint32_t i = 0; i < text.chunk_count; ++i) {
+        obj_chunk *chunk = &text.chunks[i];
+        chunk->first = text.total;
+        text.total.vertex_count += chunk->counts.vertex_count;
+        text.total.vertex_texture_count += chunk->counts.vertex_texture_count;
+        text.total.vertex_normal_count += chunk->counts.vertex_normal_count;
+        text.total.face_count += chunk->counts.face_count;
+    }
 
-    return (object){
-        .vertex_count = vertex_count,
-        .vertex_normal_count = vertex_normal_count,
-        .vertex_texture_count = vertex_texture_count,
-        .face_count = face_count,
+    return text;
+}
 
-        .arena = arena,
+// parses every chunk into sink and unmaps the file
+static void obj_text_parse(obj_text *text, const obj_sink *sink) {
+    for (uint32_t i = 0; i < text->chunk_count; ++i) {
+        text->chunks[i].total = text->total;
+        text->chunks[i].sink = sink;
+    }
 
-        .vertices = vertices,
-        .vertex_textures = vertex_textures,
-        .vertex_normals = vertex_normals,
-        .faces = faces,
-    };
-}
+    run_pass(text, parse_pass);
 
-OBJ_soa OBJ_read_file_soa(const char *obj_filepath) {
-    FILE *obj_file = fopen(obj_filepath, "r");
-    if (obj_file == NULL) {
-        fprintf(stderr, "error reading obj file: %s\n", obj_filepath);
-        exit(1);
+    if (text->map_size > 0) {
+        munmap(text->map, text->map_size);
     }
 
-    uint32_t vertex_count = 0, vertex_texture_count = 0,
-             vertex_normal_count = 0, face_count = 0;
-
-#define BUFFER_SIZE 128
-    char buffer[BUFFER_SIZE];
-
-    while (fgets(buffer, BUFFER_SIZE, obj_file)) {
-        switch (buffer[0]) {
-            case 'v': {
-                switch (buffer[1]) {
-                    case ' ': {
-                        ++vertex_count;
-                    } break;
-                    case 't': {
-                        if (buffer[2] == ' ') {
-                            ++vertex_texture_count;
-                        }
-                    } break;
-                    case 'n': {
-                        if (buffer[2] == ' ') {
-                            ++vertex_normal_count;
-                        }
-                    } break;
-                }
-            } break;
-            case 'f': {
-                if (buffer[1] == ' ') {
-                    ++face_count;
-                }
-            } break;
+    for (uint32_t i = 0; i < text->chunk_count; ++i) {
+        if (text->chunks[i].error != NULL) {
+            fprintf(stderr, "%s\n", text->chunks[i].error);
+            exit(1);
         }
     }
+}
+
+// welds the faces into out, the table starts sized for the largest array
+// and doubles whenever it fills up
+static obj_weld weld_faces(const obj_arrays *arrays, obj_counts counts,
+                           object_face *out) {
+    uint32_t n = counts.vertex_count;
+    n = counts.vertex_texture_count > n ? counts.vertex_texture_count : n;
+    n = counts.vertex_normal_count > n ? counts.vertex_normal_count : n;
+
+    obj_weld weld = {0};
+    uint32_t k = 0;
+    do {
+        uint32_t capacity =
+            weld.corners == NULL ? obj_weld_capacity(n) : 2 * weld.capacity;
+        void *block = malloc(obj_weld_size(capacity));
+        if (block == NULL) {
+            fprintf(stderr, "error malloc obj weld table\n");
+            exit(1);
+        }
+        obj_weld grown =
+            obj_weld_from(block, capacity, weld.corners != NULL ? &weld : NULL);
+        free(weld.corners);
+        weld = grown;
+
+        k += obj_weld_faces(&weld, arrays->faces + k, counts.face_count - k,
+                            out + k);
+    } while (k < counts.face_count);
+
+    return weld;
+}
 
-    if (ferror(obj_file)) {
-        fclose(obj_file);
-        fprintf(stderr, "Error reading file\n");
+object OBJ_read_file(const char *obj_filepath) {
+    obj_text text = obj_text_open(obj_filepath);
+    obj_counts counts = text.total;
+
+    void *block = malloc(obj_arrays_size(counts));
+    object_face *faces =
+        (object_face *)malloc(counts.face_count * sizeof(object_face));
+    if (block == NULL || faces == NULL) {
+        fprintf(stderr, "error malloc obj arrays\n");
         exit(1);
     }
 
+    obj_arrays arrays = obj_arrays_from(block, counts);
+    obj_sink sink = obj_sink_for(&arrays);
+
+    obj_text_parse(&text, &sink);
+
+    obj_weld weld = weld_faces(&arrays, counts, faces);
+
+    void *arena = malloc(obj_arena_size(weld.count, counts.face_count));
+    if (arena == NULL) {
+        fprintf(stderr, "error malloc obj arena\n");
+        exit(1);
+    }
+
+    object obj = obj_from_arena(arena, weld.count, counts.face_count);
+    obj.textured = counts.vertex_texture_count > 0;
+    obj_weld_vertices(&weld, 0, &arrays, obj.vertices);
+    memcpy(obj.faces, faces, counts.face_count * sizeof(object_face));
+
+    free(weld.corners);
+    free(faces);
+    free(block);
+
+    return obj;
+}
+
+OBJ_soa OBJ_read_file_soa(const char *obj_filepath) {
+    obj_text text = obj_text_open(obj_filepath);
+
+    uint32_t vertex_count = text.total.vertex_count,
+             vertex_texture_count = text.total.vertex_texture_count,
+             vertex_normal_count = text.total.vertex_normal_count,
+             face_count = text.total.face_count;
+
     void *arena = malloc(vertex_count * sizeof(point3) +
                          vertex_texture_count * sizeof(vec2) +
                          vertex_normal_count * sizeof(point3) +
-                         face_count * sizeof(object_face));
+                         face_count * sizeof(obj_file_face));
 
     if (arena == NULL) {
-        fclose(obj_file);
         fprintf(stderr, "error malloc obj arena\n");
         exit(1);
     }
@@ -227,7 +261,7 @@ OBJ_soa OBJ_read_file_soa(const char *obj_filepath) {
     };
 
     float *vertex_normal_start =
-        vertex_texture_start + 3 * vertex_texture_count;
+        vertex_texture_start + 2 * vertex_texture_count;
     point3_soa vertex_normals = {
         .x = vertex_normal_start,
         .y = vertex_normal_start + vertex_normal_count,
@@ -258,86 +292,31 @@ OBJ_soa OBJ_read_file_soa(const char *obj_filepath) {
             },
     };
 
-    uint32_t v_idx = 0, vt_idx = 0, vn_idx = 0, f_idx = 0;
-
-    float x, y, z, w;
-    uint32_t i, j, k;
+    obj_sink sink = {
+        .vertices = {vertices.x, vertices.y, vertices.z},
+        .vertex_textures = {vertex_textures.x, vertex_textures.y},
+        .vertex_normals = {vertex_normals.x, vertex_normals.y,
+                           vertex_normals.z},
+        .faces =
+            {
+                faces.vertex_idxs.x,
+                faces.vertex_idxs.y,
+                faces.vertex_idxs.z,
+                faces.vertex_texture_idxs.x,
+                faces.vertex_texture_idxs.y,
+                faces.vertex_texture_idxs.z,
+                faces.vertex_normal_idxs.x,
+                faces.vertex_normal_idxs.y,
+                faces.vertex_normal_idxs.z,
+            },
 
-    while (fscanf(obj_file, "%s", buffer) != EOF) {
-        if (ferror(obj_file)) {
-            fclose(obj_file);
-            fprintf(stderr, "Error reading file\n");
-            exit(1);
-        }
-        if (strcmp(buffer, "v") == 0) {
-            if (fscanf(obj_file, "%f %f %f %f", &x, &y, &z, &w) < 3) {
-                fclose(obj_file);
-                fprintf(stderr, "error reading vertex\n");
-                exit(1);
-            }
-            vertices.x[v_idx] = x;
-            vertices.y[v_idx] = y;
-            vertices.z[v_idx] = z;
-            ++v_idx;
-            continue;
-        }
-        if (strcmp(buffer, "vt") == 0) {
-            if (fscanf(obj_file, "%f %f %f", &x, &y, &w) < 2) {
-                fclose(obj_file);
-                fprintf(stderr, "error reading vertex texture\n");
-                exit(1);
-            }
-            vertex_textures.x[vt_idx] = x;
-            vertex_textures.y[vt_idx] = y;
-            ++vt_idx;
-            continue;
-        }
-        if (strcmp(buffer, "vn") == 0) {
-            if (fscanf(obj_file, "%f %f %f", &x, &y, &z) < 3) {
-                fclose(obj_file);
-                fprintf(stderr, "error reading vertex normals\n");
-                exit(1);
-            }
-            vertex_normals.x[vn_idx] = x;
-            vertex_normals.y[vn_idx] = y;
-            vertex_normals.z[vn_idx] = z;
-            ++vn_idx;
-            continue;
-        }
-        if (strcmp(buffer, "f") == 0) {
-            for (int h = 0; h < 3; ++h) {
-                if (fscanf(obj_file, "%u/%u/%u", &i, &j, &k) != 3) {
-                    fclose(obj_file);
-                    fprintf(stderr,
-                            "error reading face, face must contain "
-                            "vertex/vertex_texture/vertex_normal x 3");
-                    exit(1);
-                };
-
-                switch (h) {
-                    case 0: {
-                        faces.vertex_idxs.x[f_idx] = i - 1;
-                        faces.vertex_texture_idxs.x[f_idx] = j - 1;
-                        faces.vertex_normal_idxs.x[f_idx] = k - 1;
-                    } break;
-                    case 1: {
-                        faces.vertex_idxs.y[f_idx] = i - 1;
-                        faces.vertex_texture_idxs.y[f_idx] = j - 1;
-                        faces.vertex_normal_idxs.y[f_idx] = k - 1;
-                    } break;
-                    case 2: {
-                        faces.vertex_idxs.z[f_idx] = i - 1;
-                        faces.vertex_texture_idxs.z[f_idx] = j - 1;
-                        faces.vertex_normal_idxs.z[f_idx] = k - 1;
-                    } break;
-                }
-            }
-            ++f_idx;
-            continue;
-        }
-    }
+        .vertex_stride = 1,
+        .vertex_texture_stride = 1,
+        .vertex_normal_stride = 1,
+        .face_stride = 1,
+    };
 
-    fclose(obj_file);
+    obj_text_parse(&text, &sink);
 
     assert(vertex_count == vertex_normal_count);
 
@@ -345,6 +324,7 @@ OBJ_soa OBJ_read_file_soa(const char *obj_filepath) {
         .vertex_count = vertex_count,
         .vertex_texture_count = vertex_texture_count,
         .vertex_normal_count = vertex_normal_count,
+        .face_count = face_count,
 
         .arena = arena,
 
@@ -366,7 +346,7 @@ void OBJ_position_and_scale(object *obj, vec3 *posp, vec3 *rotationp,
     vec3 v, n;
 
     for (size_t i = 0; i < obj->vertex_count; ++i) {
-        v = obj->vertices[i];
+        v = obj->vertices[i].position;
 
         max_y = fmaxf(v.y, max_y);
         min_y = fminf(v.y, min_y);
@@ -404,7 +384,7 @@ void OBJ_position_and_scale(object *obj, vec3 *posp, vec3 *rotationp,
     // clang-format on
 
     for (uint32_t i = 0; i < obj->vertex_count; ++i) {
-        v = obj->vertices[i];
+        v = obj->vertices[i].position;
 
         v = vec3_sub(v, center_grav);            // center
         v = vec3_scalar_mult(v, height_adjust);  // scale
@@ -413,15 +393,15 @@ void OBJ_position_and_scale(object *obj, vec3 *posp, vec3 *rotationp,
         v = mat3_vec3_mult(yaw_rotation, v);     //
         v = vec3_add(v, pos);                    // position
 
-        obj->vertices[i] = v;
+        obj->vertices[i].position = v;
 
-        n = obj->vertex_normals[i];
+        n = obj->vertices[i].normal;
 
         n = mat3_vec3_mult(roll_rotation, n);
         n = mat3_vec3_mult(pitch_rotation, n);
         n = mat3_vec3_mult(yaw_rotation, n);
 
-        obj->vertex_normals[i] = n;
+        obj->vertices[i].normal = n;
     }
 }
 
@@ -476,7 +456,6 @@ void OBJ_position_and_scale_soa(OBJ_soa *obj, point3 pos, vec3 rotation,
 
     vec3v posv = vec3v_from_vec3(pos);
 
-    vec3v n;
     for (size_t i = 0; i < obj->vertex_count; i += 4) {
         v = vec3v_load(obj->vertices, i);
 
@@ -493,13 +472,3 @@ void OBJ_destroy(object *obj) {
     free(obj->arena);
     *obj = (object){0};
 }
-
-int main(void) {
-    OBJ_soa obj_soa = OBJ_read_file_soa("./3d/diablo3_pose.obj");
-    printf("vertex count: %d\n", obj_soa.vertex_count);
-
-    /* OBJ obj = OBJ_read_file("./3d/diablo3_pose.obj"); */
-    /* printf("vertex count: %d\n", obj.vertex_count); */
-
-    return 0;
-}
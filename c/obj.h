@@ -3,29 +3,137 @@
 
 #include "vec3.h"
 
+// one distinct v/vt/vn corner of the obj file, welded at load time so a
+// face indexes everything about a corner with one index
+typedef struct {
+    point3 position;
+    point3 normal;
+    vec2 texture;
+} object_vertex;
+
 typedef struct {
     uint32_t vertex_idxs[3];
-    uint32_t vertex_texture_idxs[3];
-    uint32_t vertex_normal_idxs[3];
 } object_face;
 
+// quantized vertex, see obj_quantize: 14 bytes instead of 32. positions
+// over the object's bounding box, octahedral normals and texture
+// coordinates over their range, each mapped back by the object's
+// object_dequantize
+typedef struct {
+    int16_t position[3];
+    int16_t normal[2];
+    uint16_t texture[2];
+} object_qvertex;
+
+// faces of quantized objects with at most 65536 vertices
+typedef struct {
+    uint16_t vertex_idxs[3];
+} object_qface;
+
+// quantized to model space, with the object transform folded in: moving a
+// quantized object changes these instead of its vertices
+typedef struct {
+    mat3 position;
+    vec3 offset;
+    mat3 normal;
+    vec2 texture_min;
+    vec2 texture_scale;
+} object_dequantize;
+
+// projected vertex, cached per object between frames. z is minus the
+// vertex's distance along the view direction and inv_w one over it
+typedef struct {
+    vec2i pixel;
+    float z;
+    float inv_w;
+} screen_vertex;
+
+// per face setup, empty (bbox_min == bbox_max) when nothing to draw
+typedef struct {
+    vec2i bbox_min;
+    vec2i bbox_max;
+} face_setup;
+
 typedef struct {
     uint32_t vertex_count;
-    uint32_t vertex_texture_count;
-    uint32_t vertex_normal_count;
     uint32_t face_count;
 
     vec3 position, rotation;
     float height;
 
+    // SHADING_PIXEL, SHADING_GOURAUD or SHADING_FLAT, see camera.h
+    uint32_t shading;
+
+    // 0 when the file has no texture coordinates, drawn in a flat colour
+    uint32_t textured;
+
     void *arena;
 
-    point3 *vertices;
-    vec2 *vertex_textures;
-    point3 *vertex_normals;
+    object_vertex *vertices;
     object_face *faces;
+
+    // screen space cache, rebuilt by rasterize_obj when the object is
+    // dirty or the camera was initialized since the last projection
+    uint32_t dirty;
+    uint32_t camera_epoch;
+
+    screen_vertex *screen_vertices;
+    face_setup *face_setups;
+
+    // lighting for the cheaper shading modes, filled in with the screen
+    // space cache. only the array the shading mode uses is kept current
+    float *vertex_intensities;
+    float *face_intensities;
+
+    // quantized layout, see obj_quantize. vertices is NULL and qvertices
+    // holds them instead, and qfaces holds the faces when every index fits
+    // 16 bits, faces is then NULL. read them through object_face_at and
+    // object_position and friends below
+    object_qvertex *qvertices;
+    object_qface *qfaces;
+    object_dequantize dequantize;
 } object;
 
+static inline object_face object_face_at(const object *obj, uint32_t k) {
+    if (obj->qfaces == NULL) {
+        return obj->faces[k];
+    }
+    const uint16_t *idxs = obj->qfaces[k].vertex_idxs;
+    return (object_face){{idxs[0], idxs[1], idxs[2]}};
+}
+
+static inline point3 object_position(const object *obj, uint32_t i) {
+    if (obj->qvertices == NULL) {
+        return obj->vertices[i].position;
+    }
+    const int16_t *q = obj->qvertices[i].position;
+    return vec3_add(mat3_vec3_mult(obj->dequantize.position,
+                                   (vec3){q[0], q[1], q[2]}),
+                    obj->dequantize.offset);
+}
+
+static inline vec3 object_normal(const object *obj, uint32_t i) {
+    if (obj->qvertices == NULL) {
+        return obj->vertices[i].normal;
+    }
+    const int16_t *q = obj->qvertices[i].normal;
+    return mat3_vec3_mult(
+        obj->dequantize.normal,
+        octahedral_to_vec3(q[0] * (1 / 32767.f), q[1] * (1 / 32767.f)));
+}
+
+static inline vec2 object_texture(const object *obj, uint32_t i) {
+    if (obj->qvertices == NULL) {
+        return obj->vertices[i].texture;
+    }
+    const uint16_t *q = obj->qvertices[i].texture;
+    const object_dequantize *d = &obj->dequantize;
+    return (vec2){
+        d->texture_min.x + q[0] * d->texture_scale.x,
+        d->texture_min.y + q[1] * d->texture_scale.y,
+    };
+}
+
 typedef struct {
     vec3i_soa vertex_idxs;
     vec3i_soa vertex_texture_idxs;
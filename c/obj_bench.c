@@ -0,0 +1,102 @@
+// times OBJ_read_file on one file, see obj_parse.h, glb_open on a glb file,
+// see glb_parse.h, or meshz_read_file on a meshz file, see meshz_parse.h
+//
+//     make obj_bench && ./obj_bench 3d/diablo3_pose.obj [runs]
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <time.h>
+
+#include "glb.h"
+#include "meshz.h"
+#include "obj.h"
+
+static double now_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e3 + ts.tv_nsec / 1e6;
+}
+
+static int compare_doubles(const void *a, const void *b) {
+    double x = *(const double *)a, y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+// the file being timed, glb files keep their mapping until closed
+static bool is_glb, is_meshz;
+static glb_file glb;
+
+static object load(const char *filepath) {
+    if (is_glb) {
+        glb = glb_open(filepath);
+        return glb.obj;
+    }
+    if (is_meshz) {
+        return meshz_read_file(filepath);
+    }
+    return OBJ_read_file(filepath);
+}
+
+static void release(object *obj) {
+    if (is_glb) {
+        glb_close(&glb);
+    } else {
+        OBJ_destroy(obj);
+    }
+}
+
+int main(int argc, char **argv) {
+    if (argc < 2) {
+        fprintf(stderr, "usage: %s <model.obj|model.glb|model.meshz> [runs]\n",
+                argv[0]);
+        return 1;
+    }
+    int runs = argc > 2 ? atoi(argv[2]) : 20;
+    if (runs < 1) {
+        runs = 1;
+    }
+
+    struct stat st;
+    if (stat(argv[1], &st) != 0) {
+        fprintf(stderr, "error reading model file: %s\n", argv[1]);
+        return 1;
+    }
+    size_t n = strlen(argv[1]);
+    is_glb = n >= 4 && strcmp(argv[1] + n - 4, ".glb") == 0;
+    is_meshz = n >= 6 && strcmp(argv[1] + n - 6, ".meshz") == 0;
+
+    // the first run also pulls the file into the page cache
+    object obj = load(argv[1]);
+    printf("%s: %u vertices, %u faces, %lld bytes\n", argv[1],
+           obj.vertex_count, obj.face_count, (long long)st.st_size);
+    // what loading produces, the object arrays
+    double array_size = obj.vertex_count * sizeof(object_vertex) +
+                        obj.face_count * sizeof(object_face);
+    release(&obj);
+
+    double *times = (double *)malloc(runs * sizeof(double));
+    if (times == NULL) {
+        fprintf(stderr, "error malloc times\n");
+        return 1;
+    }
+
+    for (int i = 0; i < runs; ++i) {
+        double start = now_ms();
+        obj = load(argv[1]);
+        times[i] = now_ms() - start;
+        release(&obj);
+    }
+
+    qsort(times, runs, sizeof(double), compare_doubles);
+    double median = times[runs / 2];
+    printf("min %.2f ms, median %.2f ms, %.0f MB/s in, %.0f MB/s out\n",
+           times[0], median, st.st_size / 1e3 / median,
+           array_size / 1e3 / median);
+
+    free(times);
+    return 0;
+}
@@ -0,0 +1,612 @@
+#include "obj_parse.h"
+
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+enum {
+    LINE_OTHER,
+    LINE_VERTEX,
+    LINE_VERTEX_TEXTURE,
+    LINE_VERTEX_NORMAL,
+    LINE_FACE,
+};
+
+static inline bool is_blank(char c) { return c == ' ' || c == '\t'; }
+
+static inline bool is_digit(char c) { return (unsigned char)(c - '0') < 10; }
+
+static inline const char *skip_blanks(const char *p, const char *end) {
+    while (p < end && is_blank(*p)) {
+        ++p;
+    }
+    return p;
+}
+
+static inline const char *line_end(const char *p, const char *end) {
+    const char *nl = (const char *)memchr(p, '\n', end - p);
+    return nl == NULL ? end : nl;
+}
+
+const char *obj_next_line(const char *p, const char *end) {
+    const char *nl = line_end(p, end);
+    return nl == end ? end : nl + 1;
+}
+
+// kind of the line starting at p, which is moved past the keyword
+static inline int line_kind(const char **pp, const char *end) {
+    const char *p = *pp;
+    if (end - p < 2) {
+        return LINE_OTHER;
+    }
+
+    if (p[0] == 'f' && is_blank(p[1])) {
+        *pp = p + 2;
+        return LINE_FACE;
+    }
+    if (p[0] != 'v') {
+        return LINE_OTHER;
+    }
+    if (is_blank(p[1])) {
+        *pp = p + 2;
+        return LINE_VERTEX;
+    }
+    if (end - p < 3 || !is_blank(p[2])) {
+        return LINE_OTHER;
+    }
+    *pp = p + 3;
+    switch (p[1]) {
+        case 't':
+            return LINE_VERTEX_TEXTURE;
+        case 'n':
+            return LINE_VERTEX_NORMAL;
+    }
+    return LINE_OTHER;
+}
+
+obj_counts obj_count_chunk(const char *p, const char *end) {
+    obj_counts counts = {0};
+
+    while (p < end) {
+        p = skip_blanks(p, end);
+
+        switch (line_kind(&p, end)) {
+            case LINE_VERTEX: {
+                ++counts.vertex_count;
+            } break;
+            case LINE_VERTEX_TEXTURE: {
+                ++counts.vertex_texture_count;
+            } break;
+            case LINE_VERTEX_NORMAL: {
+                ++counts.vertex_normal_count;
+            } break;
+            case LINE_FACE: {
+                ++counts.face_count;
+            } break;
+        }
+
+        p = obj_next_line(p, end);
+    }
+
+    return counts;
+}
+
+static const double powers_of_ten[] = {
+    1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22,
+};
+
+#define MAX_FAST_MANTISSA (1ull << 53)
+#define MAX_FAST_EXPONENT 22
+#define MAX_FLOAT_LENGTH 64
+
+// decimal float, NULL when there is none at p. digits are gathered into an
+// integer, which with fewer than 2^53 and a power of ten up to 1e22 are
+// both exact doubles, so the one multiply or divide rounds correctly.
+// anything longer goes through strtof
+static const char *parse_float(const char *p, const char *end, float *out) {
+    const char *start = p;
+
+    bool negative = false;
+    if (p < end && (*p == '-' || *p == '+')) {
+        negative = *p == '-';
+        ++p;
+    }
+
+    uint64_t mantissa = 0;
+    int exponent = 0;
+    bool exact = true;
+    const char *digits = p;
+
+    for (; p < end && is_digit(*p); ++p) {
+        if (mantissa < MAX_FAST_MANTISSA / 10) {
+            mantissa = mantissa * 10 + (*p - '0');
+        } else {
+            exact = false;
+        }
+    }
+    size_t digit_count = p - digits;
+
+    if (p < end && *p == '.') {
+        const char *fraction = ++p;
+        for (; p < end && is_digit(*p); ++p) {
+            if (mantissa < MAX_FAST_MANTISSA / 10) {
+                mantissa = mantissa * 10 + (*p - '0');
+                --exponent;
+            } else if (*p != '0') {
+                exact = false;
+            }
+        }
+        digit_count += p - fraction;
+    }
+
+    if (digit_count == 0) {
+        return NULL;
+    }
+
+    if (p < end && (*p == 'e' || *p == 'E')) {
+        const char *e = p + 1;
+        bool e_negative = false;
+        if (e < end && (*e == '-' || *e == '+')) {
+            e_negative = *e == '-';
+            ++e;
+        }
+        if (e < end && is_digit(*e)) {
+            int n = 0;
+            for (; e < end && is_digit(*e); ++e) {
+                if (n < 10000) {
+                    n = n * 10 + (*e - '0');
+                }
+            }
+            exponent += e_negative ? -n : n;
+            p = e;
+        }
+    }
+
+    if (exact && exponent >= -MAX_FAST_EXPONENT &&
+        exponent <= MAX_FAST_EXPONENT) {
+        double value = exponent < 0
+                           ? (double)mantissa / powers_of_ten[-exponent]
+                           : (double)mantissa * powers_of_ten[exponent];
+        *out = (float)(negative ? -value : value);
+        return p;
+    }
+
+    // the chunk is not terminated, strtof gets a copy
+    char buffer[MAX_FLOAT_LENGTH];
+    size_t n = p - start;
+    if (n >= MAX_FLOAT_LENGTH) {
+        return NULL;
+    }
+    memcpy(buffer, start, n);
+    buffer[n] = '\0';
+    *out = strtof(buffer, NULL);
+    return p;
+}
+
+// 1 based obj index, NULL when there is none or it is out of range
+static inline const char *parse_index(const char *p, const char *end,
+                                      uint32_t count, uint32_t *out) {
+    const char *digits = p;
+    uint64_t n = 0;
+    for (; p < end && is_digit(*p) && n <= count; ++p) {
+        n = n * 10 + (*p - '0');
+    }
+    if (p == digits || n == 0 || n > count) {
+        return NULL;
+    }
+    *out = (uint32_t)(n - 1);
+    return p;
+}
+
+static inline const char *parse_floats(const char *p, const char *end,
+                                       int n, float *out) {
+    for (int i = 0; i < n; ++i) {
+        p = skip_blanks(p, end);
+        p = parse_float(p, end, out + i);
+        if (p == NULL) {
+            return NULL;
+        }
+    }
+    return p;
+}
+
+const char *obj_parse_chunk(const char *p, const char *end, obj_counts first,
+                            obj_counts total, const obj_sink *sink) {
+    uint32_t v_idx = first.vertex_count, vt_idx = first.vertex_texture_count,
+             vn_idx = first.vertex_normal_count, f_idx = first.face_count;
+
+    float f[3];
+
+    while (p < end) {
+        p = skip_blanks(p, end);
+        const char *eol = line_end(p, end);
+
+        switch (line_kind(&p, eol)) {
+            case LINE_VERTEX: {
+                if (parse_floats(p, eol, 3, f) == NULL) {
+                    return "error reading vertex";
+                }
+                size_t i = (size_t)v_idx++ * sink->vertex_stride;
+                sink->vertices[0][i] = f[0];
+                sink->vertices[1][i] = f[1];
+                sink->vertices[2][i] = f[2];
+            } break;
+            case LINE_VERTEX_TEXTURE: {
+                if (parse_floats(p, eol, 2, f) == NULL) {
+                    return "error reading vertex texture";
+                }
+                size_t i = (size_t)vt_idx++ * sink->vertex_texture_stride;
+                sink->vertex_textures[0][i] = f[0];
+                sink->vertex_textures[1][i] = f[1];
+            } break;
+            case LINE_VERTEX_NORMAL: {
+                if (parse_floats(p, eol, 3, f) == NULL) {
+                    return "error reading vertex normals";
+                }
+                size_t i = (size_t)vn_idx++ * sink->vertex_normal_stride;
+                sink->vertex_normals[0][i] = f[0];
+                sink->vertex_normals[1][i] = f[1];
+                sink->vertex_normals[2][i] = f[2];
+            } break;
+            case LINE_FACE: {
+                size_t i = (size_t)f_idx++ * sink->face_stride;
+                for (int h = 0; h < 3; ++h) {
+                    uint32_t v, vt, vn;
+                    p = skip_blanks(p, eol);
+                    p = parse_index(p, eol, total.vertex_count, &v);
+                    if (p != NULL && p < eol && *p == '/') {
+                        p = parse_index(p + 1, eol,
+                                        total.vertex_texture_count, &vt);
+                    } else {
+                        p = NULL;
+                    }
+                    if (p != NULL && p < eol && *p == '/') {
+                        p = parse_index(p + 1, eol,
+                                        total.vertex_normal_count, &vn);
+                    } else {
+                        p = NULL;
+                    }
+                    if (p == NULL) {
+                        return "error reading face, face must contain "
+                               "vertex/vertex_texture/vertex_normal x 3";
+                    }
+                    sink->faces[h][i] = v;
+                    sink->faces[h + 3][i] = vt;
+                    sink->faces[h + 6][i] = vn;
+                }
+            } break;
+        }
+
+        p = eol == end ? end : eol + 1;
+    }
+
+    return NULL;
+}
+
+size_t obj_arrays_size(obj_counts counts) {
+    return counts.vertex_count * sizeof(point3) +
+           counts.vertex_texture_count * sizeof(vec2) +
+           counts.vertex_normal_count * sizeof(point3) +
+           counts.face_count * sizeof(obj_file_face);
+}
+
+obj_arrays obj_arrays_from(void *block, obj_counts counts) {
+    point3 *vertices = (point3 *)block;
+
+    vec2 *vertex_textures = (vec2 *)(vertices + counts.vertex_count);
+
+    point3 *vertex_normals =
+        (point3 *)(vertex_textures + counts.vertex_texture_count);
+
+    obj_file_face *faces =
+        (obj_file_face *)(vertex_normals + counts.vertex_normal_count);
+
+    return (obj_arrays){
+        .vertices = vertices,
+        .vertex_textures = vertex_textures,
+        .vertex_normals = vertex_normals,
+        .faces = faces,
+    };
+}
+
+obj_sink obj_sink_for(const obj_arrays *arrays) {
+    obj_file_face *faces = arrays->faces;
+    return (obj_sink){
+        .vertices = {&arrays->vertices->x, &arrays->vertices->y,
+                     &arrays->vertices->z},
+        .vertex_textures = {&arrays->vertex_textures->x,
+                            &arrays->vertex_textures->y},
+        .vertex_normals = {&arrays->vertex_normals->x,
+                           &arrays->vertex_normals->y,
+                           &arrays->vertex_normals->z},
+        .faces =
+            {
+                &faces->vertex_idxs[0],
+                &faces->vertex_idxs[1],
+                &faces->vertex_idxs[2],
+                &faces->vertex_texture_idxs[0],
+                &faces->vertex_texture_idxs[1],
+                &faces->vertex_texture_idxs[2],
+                &faces->vertex_normal_idxs[0],
+                &faces->vertex_normal_idxs[1],
+                &faces->vertex_normal_idxs[2],
+            },
+
+        .vertex_stride = sizeof(point3) / sizeof(float),
+        .vertex_texture_stride = sizeof(vec2) / sizeof(float),
+        .vertex_normal_stride = sizeof(point3) / sizeof(float),
+        .face_stride = sizeof(obj_file_face) / sizeof(uint32_t),
+    };
+}
+
+uint32_t obj_weld_capacity(uint32_t n) {
+    uint32_t capacity = 4;
+    while (capacity < n && capacity < (1u << 31)) {
+        capacity *= 2;
+    }
+    return capacity;
+}
+
+size_t obj_weld_size(uint32_t capacity) {
+    return capacity * sizeof(obj_corner) + 2 * capacity * sizeof(uint32_t);
+}
+
+static inline uint32_t hash_corner(obj_corner c) {
+    uint32_t h = c.v * 0x9e3779b1u ^ c.vt * 0x85ebca77u ^ c.vn * 0xc2b2ae3du;
+    return h ^ h >> 15;
+}
+
+static inline bool same_corner(obj_corner a, obj_corner b) {
+    return a.v == b.v && a.vt == b.vt && a.vn == b.vn;
+}
+
+// slot of c, or of the empty one where it would go
+static inline uint32_t *find_slot(const obj_weld *weld, obj_corner c) {
+    uint32_t mask = 2 * weld->capacity - 1;
+    uint32_t i = hash_corner(c) & mask;
+    while (weld->slots[i] != 0 &&
+           !same_corner(weld->corners[weld->slots[i] - 1], c)) {
+        i = (i + 1) & mask;
+    }
+    return &weld->slots[i];
+}
+
+obj_weld obj_weld_from(void *block, uint32_t capacity, const obj_weld *from) {
+    obj_weld weld = {
+        .corners = (obj_corner *)block,
+        .slots = (uint32_t *)((obj_corner *)block + capacity),
+        .capacity = capacity,
+    };
+    memset(weld.slots, 0, 2 * capacity * sizeof(uint32_t));
+
+    if (from != NULL) {
+        memcpy(weld.corners, from->corners, from->count * sizeof(obj_corner));
+        weld.count = from->count;
+        for (uint32_t i = 0; i < weld.count; ++i) {
+            *find_slot(&weld, weld.corners[i]) = i + 1;
+        }
+    }
+    return weld;
+}
+
+uint32_t obj_weld_corner(obj_weld *weld, obj_corner c) {
+    uint32_t *slot = find_slot(weld, c);
+    if (*slot == 0) {
+        weld->corners[weld->count] = c;
+        *slot = ++weld->count;
+    }
+    return *slot - 1;
+}
+
+uint32_t obj_weld_faces(obj_weld *weld, const obj_file_face *faces,
+                        uint32_t face_count, object_face *out) {
+    uint32_t k = 0;
+    for (; k < face_count && weld->count + 3 <= weld->capacity; ++k) {
+        obj_file_face f = faces[k];
+        for (int h = 0; h < 3; ++h) {
+            obj_corner c = {
+                f.vertex_idxs[h],
+                f.vertex_texture_idxs[h],
+                f.vertex_normal_idxs[h],
+            };
+            out[k].vertex_idxs[h] = obj_weld_corner(weld, c);
+        }
+    }
+    return k;
+}
+
+void obj_weld_vertices(const obj_weld *weld, uint32_t first,
+                       const obj_arrays *arrays, object_vertex *out) {
+    for (uint32_t i = first; i < weld->count; ++i) {
+        obj_corner c = weld->corners[i];
+        out[i] = (object_vertex){
+            .position = arrays->vertices[c.v],
+            .normal = arrays->vertex_normals[c.vn],
+            .texture = arrays->vertex_textures[c.vt],
+        };
+    }
+}
+
+size_t obj_cache_size(uint32_t vertex_count, uint32_t face_count) {
+    return vertex_count * sizeof(screen_vertex) +
+           face_count * sizeof(face_setup) + vertex_count * sizeof(float) +
+           face_count * sizeof(float);
+}
+
+size_t obj_arena_size(uint32_t vertex_count, uint32_t face_count) {
+    return vertex_count * sizeof(object_vertex) +
+           face_count * sizeof(object_face) +
+           obj_cache_size(vertex_count, face_count);
+}
+
+object obj_from_arrays(object_vertex *vertices, object_face *faces,
+                       uint32_t vertex_count, uint32_t face_count,
+                       void *cache) {
+    screen_vertex *screen_vertices = (screen_vertex *)cache;
+
+    face_setup *face_setups = (face_setup *)(screen_vertices + vertex_count);
+
+    float *vertex_intensities = (float *)(face_setups + face_count);
+
+    float *face_intensities = vertex_intensities + vertex_count;
+
+    return (object){
+        .vertex_count = vertex_count,
+        .face_count = face_count,
+
+        .arena = cache,
+
+        .vertices = vertices,
+        .faces = faces,
+
+        .dirty = 1,
+        .screen_vertices = screen_vertices,
+        .face_setups = face_setups,
+
+        .vertex_intensities = vertex_intensities,
+        .face_intensities = face_intensities,
+    };
+}
+
+object obj_from_arena(void *arena, uint32_t vertex_count,
+                      uint32_t face_count) {
+    object_vertex *vertices = (object_vertex *)arena;
+
+    object_face *faces = (object_face *)(vertices + vertex_count);
+
+    object obj = obj_from_arrays(vertices, faces, vertex_count, face_count,
+                                 faces + face_count);
+    obj.arena = arena;
+    return obj;
+}
+
+// 16 bit indices reach this many vertices
+#define OBJ_QFACE_VERTICES 65536
+
+static size_t quantized_arrays_size(uint32_t vertex_count,
+                                    uint32_t face_count) {
+    size_t face_size = vertex_count <= OBJ_QFACE_VERTICES
+                           ? sizeof(object_qface)
+                           : sizeof(object_face);
+    size_t size =
+        vertex_count * sizeof(object_qvertex) + face_count * face_size;
+    // keeps the cache after the arrays aligned
+    return (size + 15) & ~(size_t)15;
+}
+
+size_t obj_quantized_size(uint32_t vertex_count, uint32_t face_count) {
+    return quantized_arrays_size(vertex_count, face_count) +
+           obj_cache_size(vertex_count, face_count);
+}
+
+// x in -1..1 to -32767..32767, and x in 0..1 to 0..65535, rounded
+static int16_t quantize_snorm(float x) {
+    float q = x * 32767 + (x >= 0 ? 0.5f : -0.5f);
+    return q >= 32767 ? 32767 : q <= -32767 ? -32767 : (int16_t)q;
+}
+
+static uint16_t quantize_unorm(float x) {
+    float q = x * 65535 + 0.5f;
+    return q >= 65535 ? 65535 : q <= 0 ? 0 : (uint16_t)q;
+}
+
+object obj_quantize(const object *obj, void *arena) {
+    uint32_t vertex_count = obj->vertex_count;
+    uint32_t face_count = obj->face_count;
+    bool short_faces = vertex_count <= OBJ_QFACE_VERTICES;
+
+    object_qvertex *qvertices = (object_qvertex *)arena;
+    void *faces = qvertices + vertex_count;
+    void *cache = (uint8_t *)arena +
+                  quantized_arrays_size(vertex_count, face_count);
+
+    object q = obj_from_arrays(
+        NULL, short_faces ? NULL : (object_face *)faces, vertex_count,
+        face_count, cache);
+    q.arena = arena;
+    q.qvertices = qvertices;
+    q.qfaces = short_faces ? (object_qface *)faces : NULL;
+
+    q.position = obj->position;
+    q.rotation = obj->rotation;
+    q.height = obj->height;
+    q.shading = obj->shading;
+    q.textured = obj->textured;
+
+    point3 min = {INFINITY, INFINITY, INFINITY};
+    point3 max = {-INFINITY, -INFINITY, -INFINITY};
+    vec2 texture_min = {INFINITY, INFINITY};
+    vec2 texture_max = {-INFINITY, -INFINITY};
+    for (uint32_t i = 0; i < vertex_count; ++i) {
+        point3 p = object_position(obj, i);
+        min = (point3){fminf(min.x, p.x), fminf(min.y, p.y),
+                       fminf(min.z, p.z)};
+        max = (point3){fmaxf(max.x, p.x), fmaxf(max.y, p.y),
+                       fmaxf(max.z, p.z)};
+
+        vec2 t = object_texture(obj, i);
+        texture_min = (vec2){fminf(texture_min.x, t.x),
+                             fminf(texture_min.y, t.y)};
+        texture_max = (vec2){fmaxf(texture_max.x, t.x),
+                             fmaxf(texture_max.y, t.y)};
+    }
+
+    // positions go to -32767..32767 over the box around the center, flat
+    // axes all to 0
+    point3 center = vec3_scalar_mult(vec3_add(min, max), 0.5f);
+    vec3 half = vec3_scalar_mult(vec3_sub(max, min), 0.5f);
+    vec3 step = vec3_scalar_divide(half, 32767);
+    vec2 texture_scale = {(texture_max.x - texture_min.x) / 65535,
+                          (texture_max.y - texture_min.y) / 65535};
+
+    q.dequantize = (object_dequantize){
+        .position = {{{step.x, 0, 0}, {0, step.y, 0}, {0, 0, step.z}}},
+        .offset = center,
+        .normal = {{{1, 0, 0}, {0, 1, 0}, {0, 0, 1}}},
+        .texture_min = texture_min,
+        .texture_scale = texture_scale,
+    };
+    if (vertex_count == 0) {
+        q.dequantize.offset = (point3){0, 0, 0};
+        q.dequantize.texture_min = (vec2){0, 0};
+    }
+
+    for (uint32_t i = 0; i < vertex_count; ++i) {
+        point3 p = vec3_sub(object_position(obj, i), center);
+        vec2 n = vec3_to_octahedral(object_normal(obj, i));
+        vec2 t = object_texture(obj, i);
+
+        qvertices[i] = (object_qvertex){
+            .position =
+                {
+                    half.x > 0 ? quantize_snorm(p.x / half.x) : 0,
+                    half.y > 0 ? quantize_snorm(p.y / half.y) : 0,
+                    half.z > 0 ? quantize_snorm(p.z / half.z) : 0,
+                },
+            .normal = {quantize_snorm(n.x), quantize_snorm(n.y)},
+            .texture =
+                {
+                    texture_scale.x > 0
+                        ? quantize_unorm((t.x - texture_min.x) /
+                                         (texture_max.x - texture_min.x))
+                        : 0,
+                    texture_scale.y > 0
+                        ? quantize_unorm((t.y - texture_min.y) /
+                                         (texture_max.y - texture_min.y))
+                        : 0,
+                },
+        };
+    }
+
+    for (uint32_t k = 0; k < face_count; ++k) {
+        object_face f = object_face_at(obj, k);
+        if (short_faces) {
+            q.qfaces[k] = (object_qface){{f.vertex_idxs[0], f.vertex_idxs[1],
+                                          f.vertex_idxs[2]}};
+        } else {
+            q.faces[k] = f;
+        }
+    }
+    return q;
+}
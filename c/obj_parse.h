@@ -0,0 +1,141 @@
+#ifndef OBJ_PARSE_H
+#define OBJ_PARSE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "obj.h"
+
+// obj text is parsed in two passes over newline aligned chunks. the first
+// counts the elements of every chunk, a prefix sum over the counts gives
+// each chunk the index of its first elements, and the second writes them
+// there. chunks are independent in both passes, so they can run in
+// parallel. nothing here allocates or reads past the chunk
+
+typedef struct {
+    uint32_t vertex_count;
+    uint32_t vertex_texture_count;
+    uint32_t vertex_normal_count;
+    uint32_t face_count;
+} obj_counts;
+
+// where elements are written: element i of array k goes to
+// vertices[k][i * vertex_stride] and so on, which covers both the object
+// arrays and the soa ones
+typedef struct {
+    float *vertices[3];
+    float *vertex_textures[2];
+    float *vertex_normals[3];
+    // vertex, vertex texture and vertex normal index of each corner
+    uint32_t *faces[9];
+
+    uint32_t vertex_stride;
+    uint32_t vertex_texture_stride;
+    uint32_t vertex_normal_stride;
+    uint32_t face_stride;
+} obj_sink;
+
+// start of the line after the one at or after p, end when there is none
+const char *obj_next_line(const char *p, const char *end);
+
+obj_counts obj_count_chunk(const char *begin, const char *end);
+
+// first is the sum of the counts of the chunks before this one, total of
+// all of them, to bound face indices. returns NULL or what went wrong
+const char *obj_parse_chunk(const char *begin, const char *end,
+                            obj_counts first, obj_counts total,
+                            const obj_sink *sink);
+
+// a face as the file has it, a separate index into each array per corner
+typedef struct {
+    uint32_t vertex_idxs[3];
+    uint32_t vertex_texture_idxs[3];
+    uint32_t vertex_normal_idxs[3];
+} obj_file_face;
+
+// the arrays of an obj file as parsed, before welding
+typedef struct {
+    point3 *vertices;
+    vec2 *vertex_textures;
+    point3 *vertex_normals;
+    obj_file_face *faces;
+} obj_arrays;
+
+size_t obj_arrays_size(obj_counts counts);
+
+obj_arrays obj_arrays_from(void *block, obj_counts counts);
+
+// sink writing into the arrays
+obj_sink obj_sink_for(const obj_arrays *arrays);
+
+// welding gives every distinct v/vt/vn corner one object vertex, numbered
+// in the order the faces first use them. corners are found again through
+// an open addressing table with twice as many slots as corners, so it is
+// at most half full
+typedef struct {
+    uint32_t v, vt, vn;
+} obj_corner;
+
+typedef struct {
+    // of each object vertex so far
+    obj_corner *corners;
+    // object vertex + 1, 0 when empty
+    uint32_t *slots;
+
+    uint32_t count;
+    // a power of two
+    uint32_t capacity;
+} obj_weld;
+
+// capacity of the smallest table with room for n corners
+uint32_t obj_weld_capacity(uint32_t n);
+
+// bytes of a table with room for capacity corners
+size_t obj_weld_size(uint32_t capacity);
+
+// table in block, empty or with the corners of from when it is not NULL
+obj_weld obj_weld_from(void *block, uint32_t capacity, const obj_weld *from);
+
+// object vertex of c, added when it is new. the table must have room for
+// one more corner
+uint32_t obj_weld_corner(obj_weld *weld, obj_corner c);
+
+// welds faces into out, stopping early when the next face might not fit.
+// returns how many faces it welded
+uint32_t obj_weld_faces(obj_weld *weld, const obj_file_face *faces,
+                        uint32_t face_count, object_face *out);
+
+// object vertices first up to weld->count, gathered from the arrays
+void obj_weld_vertices(const obj_weld *weld, uint32_t first,
+                       const obj_arrays *arrays, object_vertex *out);
+
+// bytes of the screen space cache of an object with these counts
+size_t obj_cache_size(uint32_t vertex_count, uint32_t face_count);
+
+// bytes of the arena of an object with these counts: its arrays followed by
+// the screen space cache
+size_t obj_arena_size(uint32_t vertex_count, uint32_t face_count);
+
+// object over arrays kept elsewhere, a mapped file say, with its screen
+// space cache laid out in cache, which becomes its arena. dirty and
+// otherwise zeroed
+object obj_from_arrays(object_vertex *vertices, object_face *faces,
+                       uint32_t vertex_count, uint32_t face_count,
+                       void *cache);
+
+// object with its arrays laid out in arena, dirty and otherwise zeroed
+object obj_from_arena(void *arena, uint32_t vertex_count,
+                      uint32_t face_count);
+
+// bytes of the arena of a quantized object with these counts
+size_t obj_quantized_size(uint32_t vertex_count, uint32_t face_count);
+
+// quantized copy of obj, float or quantized, laid out in arena like
+// obj_from_arena lays out a float one. arena must not overlap the arrays
+// of obj, unless it is the arena obj_from_arena laid them out in: each
+// quantized element is smaller and written after the float ones it
+// covers are read. positions are quantized over the bounding box of the
+// object as placed, its position, rotation, height and shading carry over
+object obj_quantize(const object *obj, void *arena);
+
+#endif  // OBJ_PARSE_H
@@ -0,0 +1,683 @@
+#include "raster_kernel.h"
+
+#include <math.h>
+
+#include "shade.h"
+
+// barycentric before the divide, scaled by twice the signed area. for
+// integer vertices and positions on a 1/8 pixel grid every term is exact,
+// so two triangles agree on which side of a shared edge a sample falls
+static vec3 edge_values(vec2i t0, vec2i t1, vec2i t2, vec3 P) {
+    vec3 u = vec3_cross((vec3){t2.x - t0.x, t1.x - t0.x, t0.x - P.x},
+                        (vec3){t2.y - t0.y, t1.y - t0.y, t0.y - P.y});
+    vec3 e = {u.z - u.x - u.y, u.y, u.x};
+    return u.z < 0 ? vec3_scalar_mult(e, -1) : e;
+}
+
+// rotated grid, in pixels from the pixel position
+#define SAMPLE_OFFSETS_X -0.125f, 0.375f, -0.375f, 0.125f
+#define SAMPLE_OFFSETS_Y -0.375f, -0.125f, 0.125f, 0.375f
+
+// integer depth, d in units of the format, rounded and clamped into it.
+// the +0.5 goes in before the clamp, 2^24 - 0.5 is not a float
+static inline uint32_t depth_round(float d, float depth_max) {
+    return (uint32_t)fminf(fmaxf(d + 0.5f, 0), depth_max);
+}
+
+static inline v128_t depth_round4(v128_t d, v128_t depth_max) {
+    return vi_trunc(
+        vf_min(vf_max(vf_add(d, vf_splat(0.5f)), vf_splat(0)), depth_max));
+}
+
+// the depth test of 8 pixels in a row against stored, a bit for each that
+// is at least as near. d_lo and d_hi are their depths, from depth_round4
+// for the integer formats
+static inline uint32_t depth_test8_unorm16(const uint16_t *stored,
+                                           v128_t d_lo, v128_t d_hi) {
+#if defined(__wasm_simd128__)
+    // all 8 in one compare
+    v128_t d = wasm_u16x8_narrow_i32x4(d_lo, d_hi);
+    return wasm_i16x8_bitmask(wasm_u16x8_ge(d, wasm_v128_load(stored)));
+#else
+    return v_bitmask(vi_ge(d_lo, vi_load_u16x4(stored))) |
+           v_bitmask(vi_ge(d_hi, vi_load_u16x4(stored + 4))) << 4;
+#endif
+}
+
+static inline uint32_t depth_test8_float32(const float *stored, v128_t d_lo,
+                                           v128_t d_hi) {
+    return v_bitmask(vf_ge(d_lo, v_load(stored))) |
+           v_bitmask(vf_ge(d_hi, v_load(stored + 4))) << 4;
+}
+
+static inline uint32_t depth_test8_unorm24(const uint32_t *stored,
+                                           v128_t d_lo, v128_t d_hi) {
+    v128_t mask = vi_splat(DEPTH_UNORM24_MAX);
+    return v_bitmask(vi_ge(d_lo, v_and(v_load(stored), mask))) |
+           v_bitmask(vi_ge(d_hi, v_and(v_load(stored + 4), mask))) << 4;
+}
+
+// the stored integer depth of sample i, without the spare bits
+static inline uint32_t depth_load(const void *z_buffer, uint32_t format,
+                                  uint32_t i) {
+    return format == DEPTH_UNORM16
+               ? ((const uint16_t *)z_buffer)[i]
+               : ((const uint32_t *)z_buffer)[i] & DEPTH_UNORM24_MAX;
+}
+
+static inline void depth_store(void *z_buffer, uint32_t format, uint32_t i,
+                               uint32_t d) {
+    if (format == DEPTH_UNORM16) {
+        ((uint16_t *)z_buffer)[i] = d;
+    } else {
+        uint32_t *z = (uint32_t *)z_buffer + i;
+        *z = (*z & ~DEPTH_UNORM24_MAX) | d;
+    }
+}
+
+// 4 depth samples from sample i on, as stored: floats, or integers with
+// the spare bits of DEPTH_UNORM24
+static inline v128_t depth_load4(const void *z_buffer, uint32_t format,
+                                 uint32_t i) {
+    return format == DEPTH_UNORM16
+               ? vi_load_u16x4((const uint16_t *)z_buffer + i)
+               : v_load((const uint32_t *)z_buffer + i);
+}
+
+// a lane for each of d, from depth_round4 for the integer formats, that is
+// at least as near as stored, from depth_load4
+static inline v128_t depth_ge4(uint32_t format, v128_t d, v128_t stored) {
+    if (format == DEPTH_FLOAT32) {
+        return vf_ge(d, stored);
+    }
+    if (format == DEPTH_UNORM24) {
+        stored = v_and(stored, vi_splat(DEPTH_UNORM24_MAX));
+    }
+    return vi_ge(d, stored);
+}
+
+// d where pass and stored elsewhere, the spare bits stay
+static inline void depth_store4(void *z_buffer, uint32_t format, uint32_t i,
+                                v128_t d, v128_t stored, v128_t pass) {
+    if (format == DEPTH_UNORM16) {
+        vi_store_u16x4((uint16_t *)z_buffer + i, v_bitselect(d, stored, pass));
+        return;
+    }
+    if (format == DEPTH_UNORM24) {
+        pass = v_and(pass, vi_splat(DEPTH_UNORM24_MAX));
+    }
+    v_store((uint32_t *)z_buffer + i, v_bitselect(d, stored, pass));
+}
+
+// pixels the depth test takes at once without msaa
+#define DEPTH_GROUP 8
+
+// the planes of one triangle. edge values and depth are linear in screen
+// space, so every pixel is the bbox corner value plus a multiple of the
+// steps, and with msaa every sample the pixel value plus a per triangle
+// offset. both kinds of kernel evaluate depth from these the same way, so
+// a depth only pass and the shading pass after it agree on every bit
+typedef struct {
+    vec3 e0, edx, edy;
+    // twice the area, what the edge values sum to. 0 covers nothing
+    float area;
+    // integer depth in units of the format, float depth as the z it is
+    float depth0, depth_dx, depth_dy;
+    float depth_max;
+    // with RASTER_MSAA
+    v128_t sample_e1, sample_e2, sample_e3, sample_z;
+} triangle_planes;
+
+static inline __attribute__((always_inline)) triangle_planes
+setup_planes(const framebuffer *fb, const raster_triangle *t,
+             const uint32_t state) {
+    const uint32_t depth_format = RASTER_DEPTH_FORMAT(state);
+    triangle_planes pl;
+
+    vec3 depth = t->z;
+    pl.depth_max = depth_format == DEPTH_UNORM16 ? DEPTH_UNORM16_MAX
+                                                 : DEPTH_UNORM24_MAX;
+    if (depth_format != DEPTH_FLOAT32) {
+        float far = t->depth_far;
+        float scale = pl.depth_max / (far - t->depth_near);
+        depth = vec3_scalar_mult(vec3_add(t->z, (vec3){far, far, far}), scale);
+    }
+
+    vec3 P0 = {t->setup.bbox_min.x, t->setup.bbox_min.y, 0};
+    pl.e0 = edge_values(t->p1, t->p2, t->p3, P0);
+    pl.edx = vec3_sub(
+        edge_values(t->p1, t->p2, t->p3, vec3_add(P0, (vec3){1, 0, 0})),
+        pl.e0);
+    pl.edy = vec3_sub(
+        edge_values(t->p1, t->p2, t->p3, vec3_add(P0, (vec3){0, 1, 0})),
+        pl.e0);
+
+    pl.area = pl.e0.x + pl.e0.y + pl.e0.z;
+    if (pl.area == 0) {
+        return pl;
+    }
+    pl.depth0 = vec3_dot(depth, pl.e0) / pl.area;
+    pl.depth_dx = vec3_dot(depth, pl.edx) / pl.area;
+    pl.depth_dy = vec3_dot(depth, pl.edy) / pl.area;
+
+    if (state & RASTER_MSAA) {
+        v128_t ox = vf_make(SAMPLE_OFFSETS_X);
+        v128_t oy = vf_make(SAMPLE_OFFSETS_Y);
+        pl.sample_e1 = vf_add(vf_mul(ox, vf_splat(pl.edx.x)),
+                              vf_mul(oy, vf_splat(pl.edy.x)));
+        pl.sample_e2 = vf_add(vf_mul(ox, vf_splat(pl.edx.y)),
+                              vf_mul(oy, vf_splat(pl.edy.y)));
+        pl.sample_e3 = vf_add(vf_mul(ox, vf_splat(pl.edx.z)),
+                              vf_mul(oy, vf_splat(pl.edy.z)));
+        pl.sample_z = vf_add(vf_mul(ox, vf_splat(pl.depth_dx)),
+                             vf_mul(oy, vf_splat(pl.depth_dy)));
+    }
+    return pl;
+}
+
+// the samples of a pixel with edge values e inside the triangle
+static inline v128_t sample_coverage(const triangle_planes *pl, vec3 e) {
+    v128_t zero = vf_splat(0);
+    return v_and(v_and(vf_ge(vf_add(vf_splat(e.x), pl->sample_e1), zero),
+                       vf_ge(vf_add(vf_splat(e.y), pl->sample_e2), zero)),
+                 vf_ge(vf_add(vf_splat(e.z), pl->sample_e3), zero));
+}
+
+// the depths of the samples of a pixel at depth z, in the stored format
+static inline v128_t sample_depths(const triangle_planes *pl, float z,
+                                   const uint32_t depth_format) {
+    v128_t d = vf_add(vf_splat(z), pl->sample_z);
+    if (depth_format != DEPTH_FLOAT32) {
+        d = depth_round4(d, vf_splat(pl->depth_max));
+    }
+    return d;
+}
+
+// 1/w at each vertex. attributes are linear in screen space only over w, so
+// the edge values are weighted by each vertex's 1/w and normalized by their
+// sum, the 1/w plane, with one reciprocal a pixel. a vertex at or behind
+// the camera has no sensible w, its triangle is interpolated in screen
+// space
+static inline vec3 triangle_inv_w(const raster_triangle *t) {
+    vec3 inv_w = t->inv_w;
+    if (!(inv_w.x > 0 && inv_w.y > 0 && inv_w.z > 0)) {
+        inv_w = (vec3){1, 1, 1};
+    }
+    return inv_w;
+}
+
+// perspective correct barycentric coordinates of a point inside the
+// triangle with edge values weights
+static inline vec3 perspective_bc(vec3 weights, vec3 inv_w) {
+    weights = (vec3){weights.x * inv_w.x, weights.y * inv_w.y,
+                     weights.z * inv_w.z};
+    return vec3_scalar_mult(weights, 1 / (weights.x + weights.y + weights.z));
+}
+
+// the light at bc, from the normals with RASTER_PIXEL_LIGHTING and the
+// intensities otherwise. fragments below 0 are unlit and not drawn, the
+// depth only kernels leave them out the same way
+static inline __attribute__((always_inline)) float
+fragment_intensity(const raster_triangle *t, vec3 bc, const uint32_t state) {
+    if (state & RASTER_PIXEL_LIGHTING) {
+        vec3 n = vec3_add3(vec3_scalar_mult(t->n1, bc.x),
+                           vec3_scalar_mult(t->n2, bc.y),
+                           vec3_scalar_mult(t->n3, bc.z));
+        return -vec3_dot(t->light_dir, n);
+    }
+    return vec3_dot(t->intensities, bc);
+}
+
+// all lanes set for the pixels x .. x + 3 of a row that are lit, the depth
+// only kernels use it to leave out what draw leaves out. the same arithmetic
+// in the same order as perspective_bc and fragment_intensity, four pixels at
+// a time
+static inline __attribute__((always_inline)) v128_t
+lit_lanes(const raster_triangle *t, const triangle_planes *pl, vec3 row_e,
+          vec3 inv_w, v128_t dx, const uint32_t state) {
+    vec3v w = {
+        vf_mul(vf_add(vf_splat(row_e.x), vf_mul(vf_splat(pl->edx.x), dx)),
+               vf_splat(inv_w.x)),
+        vf_mul(vf_add(vf_splat(row_e.y), vf_mul(vf_splat(pl->edx.y), dx)),
+               vf_splat(inv_w.y)),
+        vf_mul(vf_add(vf_splat(row_e.z), vf_mul(vf_splat(pl->edx.z), dx)),
+               vf_splat(inv_w.z)),
+    };
+    v128_t r = vf_div(vf_splat(1), vf_add(vf_add(w.x, w.y), w.z));
+    vec3v bc = vec3v_v128_mul(w, r);
+
+    v128_t intensity;
+    if (state & RASTER_PIXEL_LIGHTING) {
+        vec3v n = vec3v_add(
+            vec3v_add(vec3v_v128_mul(vec3v_from_vec3(t->n1), bc.x),
+                      vec3v_v128_mul(vec3v_from_vec3(t->n2), bc.y)),
+            vec3v_v128_mul(vec3v_from_vec3(t->n3), bc.z));
+        intensity =
+            vf_sub(vf_splat(0), vec3v_dot(vec3v_from_vec3(t->light_dir), n));
+    } else {
+        intensity = vec3v_dot(vec3v_from_vec3(t->intensities), bc);
+    }
+    // lit unless below 0, so nan stays lit as in draw
+    return v_bitselect(vf_ge(intensity, vf_splat(0)), vi_splat(-1),
+                       vf_ge(intensity, intensity));
+}
+
+// the one inner loop. state is a constant in every kernel below, so the
+// state checks are resolved at compile time and each kernel only keeps the
+// work its state needs
+static inline __attribute__((always_inline)) void
+draw(framebuffer *fb, const raster_triangle *t, const uint32_t state) {
+    const uint32_t depth_format = RASTER_DEPTH_FORMAT(state);
+    const bool integer_depth = depth_format != DEPTH_FLOAT32;
+
+    uint8_t *image_buffer = fb->image;
+    float *z_buffer = fb->z_buffer;
+    uint32_t *sample_colors = fb->sample_colors;
+    uint32_t image_width = fb->width;
+    uint32_t image_channels = fb->channels;
+
+    vec2 bbox_min = {t->setup.bbox_min.x, t->setup.bbox_min.y};
+    vec2 bbox_max = {t->setup.bbox_max.x, t->setup.bbox_max.y};
+
+    triangle_planes pl = setup_planes(fb, t, state);
+    if (pl.area == 0) {
+        return;
+    }
+    v128_t depth_max = vf_splat(pl.depth_max);
+
+    vec3 inv_w = triangle_inv_w(t);
+
+    // without msaa depth is tested DEPTH_GROUP pixels at a time before
+    // anything else, groups behind what is drawn are skipped whole
+    const bool depth_groups = !(state & RASTER_MSAA);
+    const float group_size = depth_groups ? DEPTH_GROUP : 1;
+    v128_t lanes_lo = vf_make(0, 1, 2, 3);
+    v128_t lanes_hi = vf_make(4, 5, 6, 7);
+
+    vec3 P;
+    for (P.y = bbox_min.y; P.y < bbox_max.y; ++P.y) {
+        vec3 row_e =
+            vec3_add(pl.e0, vec3_scalar_mult(pl.edy, P.y - bbox_min.y));
+        float row_depth = pl.depth0 + pl.depth_dy * (P.y - bbox_min.y);
+        int row_idx = P.y * image_width;
+
+        for (float x0 = bbox_min.x; x0 < bbox_max.x; x0 += group_size) {
+            float x1 = fminf(x0 + group_size, bbox_max.x);
+
+            uint32_t group_pass = ~0u;
+            uint32_t group_depth[DEPTH_GROUP];
+            float group_z[DEPTH_GROUP];
+            if (depth_groups) {
+                v128_t dx = vf_splat(x0 - bbox_min.x);
+                v128_t d_lo = vf_add(
+                    vf_splat(row_depth),
+                    vf_mul(vf_splat(pl.depth_dx), vf_add(dx, lanes_lo)));
+                v128_t d_hi = vf_add(
+                    vf_splat(row_depth),
+                    vf_mul(vf_splat(pl.depth_dx), vf_add(dx, lanes_hi)));
+                if (integer_depth) {
+                    d_lo = depth_round4(d_lo, depth_max);
+                    d_hi = depth_round4(d_hi, depth_max);
+                    v_store(group_depth, d_lo);
+                    v_store(group_depth + 4, d_hi);
+                } else {
+                    v_store(group_z, d_lo);
+                    v_store(group_z + 4, d_hi);
+                }
+
+                int group_idx = row_idx + x0;
+                if (x1 - x0 < DEPTH_GROUP) {
+                    // the last pixels of the row, one by one so nothing is
+                    // read past the end of the buffer
+                    group_pass = 0;
+                    for (uint32_t i = 0; i < x1 - x0; ++i) {
+                        bool nearer =
+                            integer_depth
+                                ? group_depth[i] >=
+                                      depth_load(fb->z_buffer, depth_format,
+                                                 group_idx + i)
+                                : group_z[i] >= z_buffer[group_idx + i];
+                        group_pass |= nearer << i;
+                    }
+                } else if (depth_format == DEPTH_FLOAT32) {
+                    group_pass = depth_test8_float32(z_buffer + group_idx,
+                                                     d_lo, d_hi);
+                } else if (depth_format == DEPTH_UNORM16) {
+                    group_pass = depth_test8_unorm16(
+                        (uint16_t *)fb->z_buffer + group_idx, d_lo, d_hi);
+                } else {
+                    group_pass = depth_test8_unorm24(
+                        (uint32_t *)fb->z_buffer + group_idx, d_lo, d_hi);
+                }
+                if (group_pass == 0) {
+                    continue;
+                }
+            }
+
+            for (P.x = x0; P.x < x1; ++P.x) {
+                uint32_t lane = P.x - x0;
+                if (depth_groups && !(group_pass >> lane & 1)) {
+                    continue;
+                }
+
+                vec3 e = vec3_add(row_e,
+                                  vec3_scalar_mult(pl.edx, P.x - bbox_min.x));
+                int pixel_idx = row_idx + P.x;
+                int sample_idx = pixel_idx * FRAMEBUFFER_MSAA_SAMPLES;
+
+                // coverage, then depth before any attribute, so what a depth
+                // prepass or earlier triangles hide costs no shading
+                vec3 weights;
+                v128_t pass, stored_z, sample_zs;
+                if (state & RASTER_MSAA) {
+                    v128_t coverage = sample_coverage(&pl, e);
+                    if (!v_any_true(coverage)) {
+                        continue;
+                    }
+                    P.z = row_depth + pl.depth_dx * (P.x - bbox_min.x);
+                    sample_zs = sample_depths(&pl, P.z, depth_format);
+                    stored_z =
+                        depth_load4(fb->z_buffer, depth_format, sample_idx);
+                    pass = v_and(coverage,
+                                 depth_ge4(depth_format, sample_zs, stored_z));
+                    if (!v_any_true(pass)) {
+                        continue;
+                    }
+
+                    // shade at the closest point inside the triangle, the
+                    // pixel position itself can be outside on partly
+                    // covered pixels
+                    weights = (vec3){fmaxf(e.x, 0), fmaxf(e.y, 0),
+                                     fmaxf(e.z, 0)};
+                } else {
+                    if (e.x < 0 || e.y < 0 || e.z < 0) {
+                        continue;
+                    }
+                    weights = e;
+                }
+
+                vec3 bc = perspective_bc(weights, inv_w);
+                float intensity = fragment_intensity(t, bc, state);
+                if (intensity < 0) {
+                    continue;
+                }
+
+                uint32_t texel = t->color;
+                if (state & RASTER_TEXTURED) {
+                    vec2 texture_nidx =
+                        vec2_add3(vec2_scalar_mult(t->vt1, bc.x),
+                                  vec2_scalar_mult(t->vt2, bc.y),
+                                  vec2_scalar_mult(t->vt3, bc.z));
+
+                    texel = state & RASTER_BILINEAR
+                                ? sampler_fetch_bilinear(t->sampler,
+                                                         texture_nidx.x,
+                                                         texture_nidx.y)
+                                : sampler_fetch_nearest(t->sampler,
+                                                        texture_nidx.x,
+                                                        texture_nidx.y);
+                }
+                uint32_t pixel =
+                    shade_modulate(texel, shade_quantize(intensity));
+
+                // shaded once, stored to every sample that passed
+                if (state & RASTER_MSAA) {
+                    uint32_t *colors = sample_colors + sample_idx;
+                    depth_store4(fb->z_buffer, depth_format, sample_idx,
+                                 sample_zs, stored_z, pass);
+                    v_store(colors, v_bitselect(vi_splat(pixel),
+                                                v_load(colors), pass));
+                } else {
+                    if (integer_depth) {
+                        depth_store(fb->z_buffer, depth_format, pixel_idx,
+                                    group_depth[lane]);
+                    } else {
+                        z_buffer[pixel_idx] = group_z[lane];
+                    }
+                    *(uint32_t *)(image_buffer + pixel_idx * image_channels) =
+                        pixel;
+                }
+            }
+        }
+    }
+}
+
+// draw without color: coverage and depth only, 4 pixels at a time. for
+// depth prepasses, shadow maps and occlusion buffers
+static inline __attribute__((always_inline)) void
+draw_depth(framebuffer *fb, const raster_triangle *t, const uint32_t state) {
+    const uint32_t depth_format = RASTER_DEPTH_FORMAT(state);
+    void *z_buffer = fb->z_buffer;
+    uint32_t image_width = fb->width;
+
+    vec2 bbox_min = {t->setup.bbox_min.x, t->setup.bbox_min.y};
+    vec2 bbox_max = {t->setup.bbox_max.x, t->setup.bbox_max.y};
+
+    triangle_planes pl = setup_planes(fb, t, state);
+    if (pl.area == 0) {
+        return;
+    }
+    v128_t depth_max = vf_splat(pl.depth_max);
+    v128_t lanes = vf_make(0, 1, 2, 3);
+    v128_t zero = vf_splat(0);
+    vec3 inv_w = triangle_inv_w(t);
+
+    for (float y = bbox_min.y; y < bbox_max.y; ++y) {
+        vec3 row_e = vec3_add(pl.e0, vec3_scalar_mult(pl.edy, y - bbox_min.y));
+        float row_depth = pl.depth0 + pl.depth_dy * (y - bbox_min.y);
+        uint32_t row_idx = y * image_width;
+
+        if (state & RASTER_MSAA) {
+            for (float x = bbox_min.x; x < bbox_max.x; ++x) {
+                vec3 e =
+                    vec3_add(row_e, vec3_scalar_mult(pl.edx, x - bbox_min.x));
+                v128_t coverage = sample_coverage(&pl, e);
+                if (!v_any_true(coverage)) {
+                    continue;
+                }
+
+                float z = row_depth + pl.depth_dx * (x - bbox_min.x);
+                uint32_t sample_idx =
+                    (row_idx + x) * FRAMEBUFFER_MSAA_SAMPLES;
+                v128_t d = sample_depths(&pl, z, depth_format);
+                v128_t stored = depth_load4(z_buffer, depth_format, sample_idx);
+                v128_t pass =
+                    v_and(coverage, depth_ge4(depth_format, d, stored));
+                if (!v_any_true(pass)) {
+                    continue;
+                }
+                if (state & RASTER_LIT_ONLY) {
+                    // lit at the same point draw shades
+                    vec3 weights = {fmaxf(e.x, 0), fmaxf(e.y, 0),
+                                    fmaxf(e.z, 0)};
+                    vec3 bc = perspective_bc(weights, inv_w);
+                    if (fragment_intensity(t, bc, state) < 0) {
+                        continue;
+                    }
+                }
+                depth_store4(z_buffer, depth_format, sample_idx, d, stored,
+                             pass);
+            }
+            continue;
+        }
+
+        for (float x0 = bbox_min.x; x0 < bbox_max.x; x0 += 4) {
+            v128_t dx = vf_add(vf_splat(x0 - bbox_min.x), lanes);
+            v128_t coverage = v_and(
+                v_and(vf_ge(vf_add(vf_splat(row_e.x),
+                                   vf_mul(vf_splat(pl.edx.x), dx)),
+                            zero),
+                      vf_ge(vf_add(vf_splat(row_e.y),
+                                   vf_mul(vf_splat(pl.edx.y), dx)),
+                            zero)),
+                vf_ge(vf_add(vf_splat(row_e.z), vf_mul(vf_splat(pl.edx.z), dx)),
+                      zero));
+            if (!v_any_true(coverage)) {
+                continue;
+            }
+            if (state & RASTER_LIT_ONLY) {
+                coverage = v_and(coverage,
+                                 lit_lanes(t, &pl, row_e, inv_w, dx, state));
+                if (!v_any_true(coverage)) {
+                    continue;
+                }
+            }
+
+            v128_t d =
+                vf_add(vf_splat(row_depth), vf_mul(vf_splat(pl.depth_dx), dx));
+            if (depth_format != DEPTH_FLOAT32) {
+                d = depth_round4(d, depth_max);
+            }
+
+            uint32_t idx = row_idx + x0;
+            uint32_t count = fminf(bbox_max.x - x0, 4);
+            if (count == 4) {
+                v128_t stored = depth_load4(z_buffer, depth_format, idx);
+                v128_t pass =
+                    v_and(coverage, depth_ge4(depth_format, d, stored));
+                if (v_any_true(pass)) {
+                    depth_store4(z_buffer, depth_format, idx, d, stored, pass);
+                }
+                continue;
+            }
+
+            // the last pixels of the row, one by one so nothing is read past
+            // the end of the buffer
+            uint32_t covered = v_bitmask(coverage);
+            if (depth_format == DEPTH_FLOAT32) {
+                float dz[4];
+                v_store(dz, d);
+                for (uint32_t i = 0; i < count; ++i) {
+                    float *z = (float *)z_buffer + idx + i;
+                    if (covered >> i & 1 && dz[i] >= *z) {
+                        *z = dz[i];
+                    }
+                }
+            } else {
+                uint32_t dz[4];
+                v_store(dz, d);
+                for (uint32_t i = 0; i < count; ++i) {
+                    if (covered >> i & 1 &&
+                        dz[i] >= depth_load(z_buffer, depth_format, idx + i)) {
+                        depth_store(z_buffer, depth_format, idx + i, dz[i]);
+                    }
+                }
+            }
+        }
+    }
+}
+
+// stamps out draw_<state> for one state value
+#define RASTER_KERNEL(state)                                               \
+    static void draw_##state(framebuffer *fb, const raster_triangle *t) { \
+        draw(fb, t, state);                                               \
+    }
+
+RASTER_KERNEL(0)
+RASTER_KERNEL(1)
+RASTER_KERNEL(2)
+RASTER_KERNEL(3)
+RASTER_KERNEL(4)
+RASTER_KERNEL(5)
+RASTER_KERNEL(6)
+RASTER_KERNEL(7)
+RASTER_KERNEL(8)
+RASTER_KERNEL(9)
+RASTER_KERNEL(10)
+RASTER_KERNEL(11)
+RASTER_KERNEL(12)
+RASTER_KERNEL(13)
+RASTER_KERNEL(14)
+RASTER_KERNEL(15)
+RASTER_KERNEL(16)
+RASTER_KERNEL(17)
+RASTER_KERNEL(18)
+RASTER_KERNEL(19)
+RASTER_KERNEL(20)
+RASTER_KERNEL(21)
+RASTER_KERNEL(22)
+RASTER_KERNEL(23)
+RASTER_KERNEL(24)
+RASTER_KERNEL(25)
+RASTER_KERNEL(26)
+RASTER_KERNEL(27)
+RASTER_KERNEL(28)
+RASTER_KERNEL(29)
+RASTER_KERNEL(30)
+RASTER_KERNEL(31)
+RASTER_KERNEL(32)
+RASTER_KERNEL(33)
+RASTER_KERNEL(34)
+RASTER_KERNEL(35)
+RASTER_KERNEL(36)
+RASTER_KERNEL(37)
+RASTER_KERNEL(38)
+RASTER_KERNEL(39)
+RASTER_KERNEL(40)
+RASTER_KERNEL(41)
+RASTER_KERNEL(42)
+RASTER_KERNEL(43)
+RASTER_KERNEL(44)
+RASTER_KERNEL(45)
+RASTER_KERNEL(46)
+RASTER_KERNEL(47)
+
+static const raster_kernel raster_kernels[RASTER_STATE_COUNT] = {
+    draw_0, draw_1, draw_2, draw_3, draw_4, draw_5, draw_6, draw_7,
+    draw_8, draw_9, draw_10, draw_11, draw_12, draw_13, draw_14, draw_15,
+    draw_16, draw_17, draw_18, draw_19, draw_20, draw_21, draw_22, draw_23,
+    draw_24, draw_25, draw_26, draw_27, draw_28, draw_29, draw_30, draw_31,
+    draw_32, draw_33, draw_34, draw_35, draw_36, draw_37, draw_38, draw_39,
+    draw_40, draw_41, draw_42, draw_43, draw_44, draw_45, draw_46, draw_47,
+};
+
+raster_kernel raster_kernel_select(uint32_t state) {
+    return raster_kernels[state < RASTER_STATE_COUNT ? state : 0];
+}
+
+// the lighting of a depth only kernel, none or the RASTER_LIT_ONLY test on
+// intensities or normals
+#define DEPTH_LIGHT_BITS_0 0
+#define DEPTH_LIGHT_BITS_1 RASTER_LIT_ONLY
+#define DEPTH_LIGHT_BITS_2 (RASTER_LIT_ONLY | RASTER_PIXEL_LIGHTING)
+
+// stamps out draw_depth_<format>_<msaa>_<light>
+#define RASTER_DEPTH_KERNEL(format, msaa, light)                            \
+    static void draw_depth_##format##_##msaa##_##light(                     \
+        framebuffer *fb, const raster_triangle *t) {                        \
+        draw_depth(fb, t,                                                   \
+                   (format << RASTER_DEPTH_SHIFT) | (msaa * RASTER_MSAA) |  \
+                       DEPTH_LIGHT_BITS_##light);                           \
+    }
+
+#define RASTER_DEPTH_KERNELS(format, msaa) \
+    RASTER_DEPTH_KERNEL(format, msaa, 0)   \
+    RASTER_DEPTH_KERNEL(format, msaa, 1)   \
+    RASTER_DEPTH_KERNEL(format, msaa, 2)
+
+RASTER_DEPTH_KERNELS(0, 0)
+RASTER_DEPTH_KERNELS(0, 1)
+RASTER_DEPTH_KERNELS(1, 0)
+RASTER_DEPTH_KERNELS(1, 1)
+RASTER_DEPTH_KERNELS(2, 0)
+RASTER_DEPTH_KERNELS(2, 1)
+
+#define RASTER_DEPTH_ROW(format, msaa)                                   \
+    {draw_depth_##format##_##msaa##_0, draw_depth_##format##_##msaa##_1, \
+     draw_depth_##format##_##msaa##_2}
+
+static const raster_kernel raster_depth_kernels[DEPTH_FORMAT_COUNT][2][3] = {
+    {RASTER_DEPTH_ROW(0, 0), RASTER_DEPTH_ROW(0, 1)},
+    {RASTER_DEPTH_ROW(1, 0), RASTER_DEPTH_ROW(1, 1)},
+    {RASTER_DEPTH_ROW(2, 0), RASTER_DEPTH_ROW(2, 1)},
+};
+
+raster_kernel raster_depth_kernel_select(uint32_t state) {
+    uint32_t format = RASTER_DEPTH_FORMAT(state);
+    uint32_t light = 0;
+    if (state & RASTER_LIT_ONLY) {
+        light = state & RASTER_PIXEL_LIGHTING ? 2 : 1;
+    }
+    return raster_depth_kernels[format < DEPTH_FORMAT_COUNT ? format : 0]
+                               [(state & RASTER_MSAA) != 0][light];
+}
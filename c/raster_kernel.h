@@ -0,0 +1,61 @@
+#ifndef RASTER_KERNEL_H
+#define RASTER_KERNEL_H
+
+#include "framebuffer.h"
+#include "obj.h"
+#include "sampler.h"
+#include "vec3.h"
+
+// pipeline state bits. every combination gets its own inner loop with the
+// state folded in at compile time, see raster_kernel.c
+#define RASTER_TEXTURED (1u << 0)        // texture instead of color
+#define RASTER_BILINEAR (1u << 1)        // bilinear instead of nearest
+#define RASTER_PIXEL_LIGHTING (1u << 2)  // normals instead of intensities
+#define RASTER_MSAA (1u << 3)            // 4 coverage and depth samples
+// the depth format, DEPTH_* from framebuffer.h, in the bits above
+#define RASTER_DEPTH_SHIFT 4
+#define RASTER_DEPTH_UNORM16 (DEPTH_UNORM16 << RASTER_DEPTH_SHIFT)
+#define RASTER_DEPTH_UNORM24 (DEPTH_UNORM24 << RASTER_DEPTH_SHIFT)
+#define RASTER_STATE_COUNT (DEPTH_FORMAT_COUNT << RASTER_DEPTH_SHIFT)
+#define RASTER_DEPTH_FORMAT(state) ((state) >> RASTER_DEPTH_SHIFT & 3)
+// depth only kernels, leave out the fragments draw leaves out as unlit,
+// tested on the normals with RASTER_PIXEL_LIGHTING and intensities otherwise
+#define RASTER_LIT_ONLY (1u << 6)
+
+// one triangle with everything any kernel reads, each kernel only touches
+// the fields its state needs
+typedef struct {
+    vec2i p1, p2, p3;
+    face_setup setup;
+    // minus the distance along the view, see camera_depth
+    vec3 z;
+    // the camera's depth range, for the integer depth formats
+    float depth_near, depth_far;
+    // per vertex, for perspective correct attributes
+    vec3 inv_w;
+
+    // per vertex, without RASTER_PIXEL_LIGHTING
+    vec3 intensities;
+    // with RASTER_PIXEL_LIGHTING
+    vec3 n1, n2, n3;
+    vec3 light_dir;
+
+    // with RASTER_TEXTURED
+    vec2 vt1, vt2, vt3;
+    const sampler *sampler;
+    // packed rgba8, without RASTER_TEXTURED
+    uint32_t color;
+} raster_triangle;
+
+typedef void (*raster_kernel)(framebuffer *fb, const raster_triangle *t);
+
+// looked up once per draw
+raster_kernel raster_kernel_select(uint32_t state);
+
+// the depth only kernel for the RASTER_MSAA, RASTER_LIT_ONLY,
+// RASTER_PIXEL_LIGHTING and depth format bits of state, the rest are
+// ignored. it reads the positions, setup and z of a triangle, and inv_w and
+// the lighting with RASTER_LIT_ONLY, and writes depth alone
+raster_kernel raster_depth_kernel_select(uint32_t state);
+
+#endif  // RASTER_KERNEL_H
@@ -1,102 +1,864 @@
+#include <string.h>
+
 #include "camera.h"
 #include "float.h"
+#include "glb_parse.h"
+#include "meshz_parse.h"
+#include "obj_parse.h"
+#include "stl_parse.h"
 
 extern unsigned int __heap_base;
 
-#pragma clang diagnostic ignored "-Wincompatible-library-redeclaration"
+#define WASM_PAGE_SIZE 65536
+
+uint8_t *bump_pointer = (uint8_t *)&__heap_base;
+
+// grows memory so the next n bytes of bump_malloc are in bounds. growing
+// replaces the memory buffer on the js side, so callers holding views
+// reserve first and refresh them before allocating. 0 when the memory
+// cannot grow that far
+uint32_t bump_reserve(size_t n) {
+    uintptr_t start = (uintptr_t)bump_pointer;
+    if (n > UINTPTR_MAX - start) {
+        return 0;
+    }
+    uintptr_t end = start + n;
+    uintptr_t size = __builtin_wasm_memory_size(0) * WASM_PAGE_SIZE;
+    if (end > size &&
+        __builtin_wasm_memory_grow(
+            0, (end - size + WASM_PAGE_SIZE - 1) / WASM_PAGE_SIZE) ==
+            (size_t)-1) {
+        return 0;
+    }
+    return 1;
+}
 
-void *bump_pointer = &__heap_base;
-void *bump_malloc(int n) {
+// NULL when the memory cannot grow for it
+void *bump_malloc(size_t n) {
+    if (!bump_reserve(n)) {
+        return NULL;
+    }
     void *r = bump_pointer;
     bump_pointer += n;
     return r;
 }
 
-camera cam = {0};
+#define OBJ_ALIGNMENT 16
 
-float test_func(camera *cam) { return cam->look_at.z; }
+static uint8_t *align_up(uint8_t *p) {
+    return (uint8_t *)(((uintptr_t)p + OBJ_ALIGNMENT - 1) &
+                       ~(uintptr_t)(OBJ_ALIGNMENT - 1));
+}
 
-// position, scale, & rotate
-// you must have set the position, rotation, and height
-// in the object before invoking
-void obj_psr(object *obj) {
-    vec3 position = obj->position;
-    vec3 rotation = obj->rotation;
-    float height = obj->height;
+static void *bump_malloc_aligned(size_t n) {
+    uint8_t *p = align_up(bump_pointer);
+    size_t padding = p - bump_pointer;
+    if (n > SIZE_MAX - padding || bump_malloc(padding + n) == NULL) {
+        return NULL;
+    }
+    return p;
+}
 
-    float max_y = -FLT_MAX, min_y = FLT_MAX;
-    point3 center_grav = {0};
+// element_count elements of element_size bytes, SIZE_MAX when that does
+// not fit in the address space, which no allocation gets
+static size_t array_size(uint64_t element_count, size_t element_size) {
+    uint64_t size = element_count * element_size;
+    return size > SIZE_MAX ? SIZE_MAX : (size_t)size;
+}
 
-    vec3 v, n;
+// moves weld into a table with room for capacity corners, or starts one.
+// the old table is left behind in the bump heap. false, with weld as it
+// was, when the memory cannot grow for it
+static bool grow_weld(obj_weld *weld, uint32_t capacity) {
+    void *block = bump_malloc_aligned(obj_weld_size(capacity));
+    if (block == NULL) {
+        return false;
+    }
+    *weld = obj_weld_from(block, capacity, weld->corners != NULL ? weld : NULL);
+    return true;
+}
 
-    for (size_t i = 0; i < obj->vertex_count; ++i) {
-        v = obj->vertices[i];
+static bool weld_into(obj_weld *weld, const obj_file_face *faces,
+                      uint32_t face_count, object_face *out) {
+    uint32_t k = obj_weld_faces(weld, faces, face_count, out);
+    while (k < face_count) {
+        if (!grow_weld(weld, 2 * weld->capacity)) {
+            return false;
+        }
+        k += obj_weld_faces(weld, faces + k, face_count - k, out + k);
+    }
+    return true;
+}
 
-        max_y = fmaxf(v.y, max_y);
-        min_y = fminf(v.y, min_y);
+// same as weld_into for stl records
+static bool stl_weld_into(obj_weld *weld, const uint8_t *records,
+                          uint32_t face_count, object_face *out) {
+    uint32_t k = stl_weld_faces(weld, records, face_count, out);
+    while (k < face_count) {
+        if (!grow_weld(weld, 2 * weld->capacity)) {
+            return false;
+        }
+        k += stl_weld_faces(weld, records + (size_t)k * STL_FACE_SIZE,
+                            face_count - k, out + k);
+    }
+    return true;
+}
 
-        center_grav = vec3_add(center_grav, v);
+// the largest of the arrays, every one of its elements a face uses is at
+// least one object vertex
+static uint32_t largest_array(obj_counts counts) {
+    uint32_t n = counts.vertex_count;
+    n = counts.vertex_texture_count > n ? counts.vertex_texture_count : n;
+    n = counts.vertex_normal_count > n ? counts.vertex_normal_count : n;
+    return n;
+}
+
+// parses the obj text js copied in with the last bump_malloc. the arrays
+// as parsed, the welded faces and the weld table go after the text, then
+// the object built from them, which is moved down over the text once the
+// rest is no longer needed. NULL when it is not an obj file or the memory
+// cannot grow for it, with the memory as it was before the text
+object *obj_parse(char *text, uint32_t size) {
+    obj_counts counts = obj_count_chunk(text, text + size);
+
+    void *block = bump_malloc_aligned(obj_arrays_size(counts));
+    if (block == NULL) {
+        bump_pointer = (uint8_t *)text;
+        return NULL;
     }
+    obj_arrays arrays = obj_arrays_from(block, counts);
+    obj_sink sink = obj_sink_for(&arrays);
 
-    center_grav = vec3_scalar_divide(center_grav, obj->vertex_count);
+    if (obj_parse_chunk(text, text + size, (obj_counts){0}, counts, &sink) !=
+        NULL) {
+        bump_pointer = (uint8_t *)text;
+        return NULL;
+    }
 
-    float cur_height = max_y - min_y;
-    float height_adjust = height / cur_height;
+    object_face *faces =
+        bump_malloc_aligned(array_size(counts.face_count, sizeof(object_face)));
 
-    float theta_x = degrees_to_radians(rotation.x);
-    float theta_y = degrees_to_radians(rotation.y);
-    float theta_z = degrees_to_radians(rotation.z);
+    obj_weld weld = {0};
+    if (faces == NULL ||
+        !grow_weld(&weld, obj_weld_capacity(largest_array(counts))) ||
+        !weld_into(&weld, arrays.faces, counts.face_count, faces)) {
+        bump_pointer = (uint8_t *)text;
+        return NULL;
+    }
 
-    // clang-format off
-    mat3 roll_rotation = {{
-        {1, 0             , 0            },
-        {0, cosf(theta_x) , sinf(theta_x)},
-        {0, -sinf(theta_x), cosf(theta_x)},
-    }};
+    size_t object_size =
+        sizeof(object) + obj_arena_size(weld.count, counts.face_count);
+    uint8_t *built = bump_malloc_aligned(object_size);
+    if (built == NULL) {
+        bump_pointer = (uint8_t *)text;
+        return NULL;
+    }
 
-    mat3 pitch_rotation = {{
-        {cosf(theta_y), 0, -sinf(theta_y)},
-        {0            , 1, 0             },
-        {sinf(theta_y), 0, cosf(theta_y) },
-    }};
+    object *obj = (object *)built;
+    *obj = obj_from_arena(built + sizeof(object), weld.count,
+                          counts.face_count);
+    obj_weld_vertices(&weld, 0, &arrays, obj->vertices);
+    memcpy(obj->faces, faces, counts.face_count * sizeof(object_face));
+
+    uint8_t *moved = align_up((uint8_t *)text);
+    memmove(moved, built, object_size);
+    bump_pointer = moved + object_size;
+
+    obj = (object *)moved;
+    *obj = obj_from_arena(moved + sizeof(object), weld.count,
+                          counts.face_count);
+    obj->textured = counts.vertex_texture_count > 0;
+    return obj;
+}
 
-    mat3 yaw_rotation = {{
-        {cosf(theta_z) , sinf(theta_z), 0},
-        {-sinf(theta_z), cosf(theta_z), 0},
-        {0             , 0            , 1},
-    }};
-    // clang-format on
+// same as obj_parse for a binary stl file js copied in. the positions are
+// welded and the object is flat shaded, stl has one normal per face
+object *stl_parse(uint8_t *bytes, uint32_t size) {
+    uint32_t face_count;
+    if (!stl_face_count(bytes, size, &face_count)) {
+        bump_pointer = bytes;
+        return NULL;
+    }
+    const uint8_t *records = bytes + STL_HEADER_SIZE;
+
+    object_face *faces =
+        bump_malloc_aligned(array_size(face_count, sizeof(object_face)));
+
+    // closed meshes have about half as many positions as faces
+    obj_weld weld = {0};
+    if (faces == NULL || !grow_weld(&weld, obj_weld_capacity(face_count / 2)) ||
+        !stl_weld_into(&weld, records, face_count, faces)) {
+        bump_pointer = bytes;
+        return NULL;
+    }
+
+    size_t object_size =
+        sizeof(object) + obj_arena_size(weld.count, face_count);
+    uint8_t *built = bump_malloc_aligned(object_size);
+    if (built == NULL) {
+        bump_pointer = bytes;
+        return NULL;
+    }
+
+    object *obj = (object *)built;
+    *obj = obj_from_arena(built + sizeof(object), weld.count, face_count);
+    memcpy(obj->faces, faces, face_count * sizeof(object_face));
+    stl_weld_vertices(&weld, 0, obj->vertices);
+    stl_vertex_normals(obj);
+
+    uint8_t *moved = align_up(bytes);
+    memmove(moved, built, object_size);
+    bump_pointer = moved + object_size;
+
+    obj = (object *)moved;
+    *obj = obj_from_arena(moved + sizeof(object), weld.count, face_count);
+    obj->shading = SHADING_FLAT;
+    return obj;
+}
+
+// same as stl_parse for a glb file js copied in. when its buffers are laid
+// out as the object arrays the object points into the bytes, which stay,
+// and only the object and its screen space cache go after them. otherwise
+// the arrays are copied out and the object moved down over the bytes
+object *glb_parse(uint8_t *bytes, uint32_t size) {
+    glb_mesh mesh;
+    if (!glb_read(bytes, size, &mesh)) {
+        bump_pointer = bytes;
+        return NULL;
+    }
+    uint32_t vertex_count = mesh.vertex_count;
+    uint32_t face_count = mesh.face_count;
+
+    object *obj;
+    if (glb_in_place(&mesh)) {
+        uint8_t *built = bump_malloc_aligned(
+            sizeof(object) + obj_cache_size(vertex_count, face_count));
+        if (built == NULL) {
+            bump_pointer = bytes;
+            return NULL;
+        }
+
+        obj = (object *)built;
+        *obj = obj_from_arrays((object_vertex *)mesh.position.data,
+                               (object_face *)mesh.indices, vertex_count,
+                               face_count, built + sizeof(object));
+        glb_flip_textures(obj->vertices, vertex_count);
+    } else {
+        size_t object_size =
+            sizeof(object) + obj_arena_size(vertex_count, face_count);
+        uint8_t *built = bump_malloc_aligned(object_size);
+        if (built == NULL) {
+            bump_pointer = bytes;
+            return NULL;
+        }
+
+        obj = (object *)built;
+        *obj = obj_from_arena(built + sizeof(object), vertex_count,
+                              face_count);
+        glb_copy(&mesh, obj->vertices, obj->faces);
+
+        uint8_t *moved = align_up(bytes);
+        memmove(moved, built, object_size);
+        bump_pointer = moved + object_size;
+
+        obj = (object *)moved;
+        *obj = obj_from_arena(moved + sizeof(object), vertex_count,
+                              face_count);
+    }
+
+    // gltf asks for flat shading when there are no normals
+    if (mesh.normal.data == NULL) {
+        obj->shading = SHADING_FLAT;
+    }
+    obj->textured = mesh.texture.data != NULL;
+    return obj;
+}
+
+// same as stl_parse for a meshz file js copied in. it decodes straight
+// into the object arrays, built after the bytes and moved down over them
+object *meshz_parse(uint8_t *bytes, uint32_t size) {
+    meshz_header h;
+    if (!meshz_read_header(bytes, size, &h)) {
+        bump_pointer = bytes;
+        return NULL;
+    }
+
+    size_t object_size =
+        sizeof(object) + obj_arena_size(h.vertex_count, h.face_count);
+    uint8_t *built = bump_malloc_aligned(object_size);
+    if (built == NULL) {
+        bump_pointer = bytes;
+        return NULL;
+    }
+
+    object *obj = (object *)built;
+    *obj = obj_from_arena(built + sizeof(object), h.vertex_count,
+                          h.face_count);
+    if (!meshz_decode(bytes, &h, obj->vertices, obj->faces)) {
+        bump_pointer = bytes;
+        return NULL;
+    }
+
+    uint8_t *moved = align_up(bytes);
+    memmove(moved, built, object_size);
+    bump_pointer = moved + object_size;
+
+    obj = (object *)moved;
+    *obj = obj_from_arena(moved + sizeof(object), h.vertex_count,
+                          h.face_count);
+    if ((h.flags & MESHZ_NORMALS) == 0) {
+        obj->shading = SHADING_FLAT;
+    }
+    obj->textured = (h.flags & MESHZ_TEXTURES) != 0;
+    return obj;
+}
+
+// quantizes an object, see obj_quantize in obj_parse.h. one the parse
+// functions left at the end of the heap is quantized over its own arrays
+// and the memory they no longer need given back, any other, a stream or a
+// glb over its bytes, gets a quantized copy after it, NULL when the memory
+// cannot grow for it. an object already quantized comes back as it is
+object *quantize_obj(object *obj) {
+    if (obj->qvertices != NULL) {
+        return obj;
+    }
+    uint32_t vertex_count = obj->vertex_count;
+    uint32_t face_count = obj->face_count;
+
+    uint8_t *arena = (uint8_t *)obj + sizeof(object);
+    if (obj->arena == arena && (uint8_t *)obj->vertices == arena &&
+        arena + obj_arena_size(vertex_count, face_count) == bump_pointer) {
+        *obj = obj_quantize(obj, arena);
+        bump_pointer = arena + obj_quantized_size(vertex_count, face_count);
+        return obj;
+    }
+
+    uint8_t *built = bump_malloc_aligned(
+        sizeof(object) + obj_quantized_size(vertex_count, face_count));
+    if (built == NULL) {
+        return NULL;
+    }
+    object *quantized = (object *)built;
+    *quantized = obj_quantize(obj, built + sizeof(object));
+    return quantized;
+}
+
+// an object parsed while its file is still arriving. obj comes first, so
+// a stream is also a pointer to its object, which can be drawn between
+// calls with whatever faces have arrived
+typedef struct {
+    object obj;
+
+    // the arrays as parsed so far, which faces still to come index into.
+    // faces are welded in the call that parses them, so the face array
+    // only holds that call's and counts.face_count stays 0
+    obj_arrays arrays;
+    obj_counts counts;
+    obj_weld weld;
+
+    // elements the arrays and the blocks of obj have room for
+    obj_counts capacity;
+    uint32_t vertex_capacity;
+    uint32_t face_capacity;
+
+    // text not parsed yet, at most one partial line between calls, or for
+    // stl at most one partial record
+    char *text;
+    uint32_t text_size;
+    uint32_t text_capacity;
+
+    // size of the whole file when js knows it, 0 otherwise
+    uint32_t size;
+
+    // from the header of an stl file, once it is in
+    uint32_t stl_face_count;
+
+    // model space extent of the vertices so far, and the center and height
+    // the vertices are placed with, fixed by the first ones that have an
+    // extent and corrected once all of them are in
+    float min_y, max_y;
+    point3 center;
+    float placed_height;
+    uint32_t placed;
+} obj_stream;
+
+// object vertices and faces share their block with the cache arrays sized
+// like them, elements first. a file streams in section by section, so the
+// block growing is usually the last allocation and grows in place
+#define VERTEX_BLOCK_SIZE \
+    (sizeof(object_vertex) + sizeof(screen_vertex) + sizeof(float))
+#define FACE_BLOCK_SIZE \
+    (sizeof(object_face) + sizeof(face_setup) + sizeof(float))
+
+// size is that of the whole file, or 0 when it is not known. NULL when the
+// memory cannot grow for the stream
+obj_stream *obj_stream_begin(uint32_t size) {
+    obj_stream *s = bump_malloc_aligned(sizeof(obj_stream));
+    if (s == NULL) {
+        return NULL;
+    }
+    *s = (obj_stream){
+        .obj = {.dirty = 1},
+        .size = size,
+        .min_y = FLT_MAX,
+        .max_y = -FLT_MAX,
+    };
+    return s;
+}
+
+// where the next n bytes of text go before obj_stream_parse. may grow the
+// memory, NULL when it cannot
+char *obj_stream_buffer(obj_stream *s, uint32_t n) {
+    // the buffer is allocated twice as large as needed
+    if (n > UINT32_MAX / 2 - s->text_size) {
+        return NULL;
+    }
+    if (s->text_size + n > s->text_capacity) {
+        uint32_t capacity = 2 * (s->text_size + n);
+        char *text = bump_malloc(capacity);
+        if (text == NULL) {
+            return NULL;
+        }
+        if (s->text_size > 0) {
+            memcpy(text, s->text, s->text_size);
+        }
+        s->text = text;
+        s->text_capacity = capacity;
+    }
+    return s->text + s->text_size;
+}
+
+// block of size bytes keeping the used bytes of the old one, which is
+// left behind in the bump heap unless it could grow in place. NULL, with
+// the old block as it was, when the memory cannot grow for it
+static void *grow_block(void *block, size_t old_size, size_t used,
+                        size_t size) {
+    if (block != NULL && (uint8_t *)block + old_size == bump_pointer) {
+        return bump_malloc(size - old_size) != NULL ? block : NULL;
+    }
+    void *grown = bump_malloc_aligned(size);
+    if (grown != NULL && used > 0) {
+        memcpy(grown, block, used);
+    }
+    return grown;
+}
+
+// the cache arrays of the blocks, after the elements
+static void point_into_blocks(obj_stream *s) {
+    object *obj = &s->obj;
+
+    obj->screen_vertices =
+        (screen_vertex *)(obj->vertices + s->vertex_capacity);
+    obj->vertex_intensities =
+        (float *)(obj->screen_vertices + s->vertex_capacity);
+    obj->face_setups = (face_setup *)(obj->faces + s->face_capacity);
+    obj->face_intensities = (float *)(obj->face_setups + s->face_capacity);
+}
+
+static uint32_t grown_capacity(uint32_t capacity, uint32_t needed) {
+    uint64_t grown = (uint64_t)capacity * 2;
+    grown = grown > needed ? grown : needed;
+    return grown > UINT32_MAX ? UINT32_MAX : (uint32_t)grown;
+}
+
+// room for needed elements in the arrays, of which only this call's faces
+// are needed so far. false when the memory cannot grow for them
+static bool reserve_arrays(obj_stream *s, obj_counts needed) {
+    obj_arrays *arrays = &s->arrays;
+    obj_counts *capacity = &s->capacity;
+    uint32_t c;
+    void *block;
+
+    if (needed.vertex_count > capacity->vertex_count) {
+        c = grown_capacity(capacity->vertex_count, needed.vertex_count);
+        block = grow_block(
+            arrays->vertices, capacity->vertex_count * sizeof(point3),
+            s->counts.vertex_count * sizeof(point3),
+            array_size(c, sizeof(point3)));
+        if (block == NULL) {
+            return false;
+        }
+        arrays->vertices = block;
+        capacity->vertex_count = c;
+    }
+
+    if (needed.vertex_texture_count > capacity->vertex_texture_count) {
+        c = grown_capacity(capacity->vertex_texture_count,
+                           needed.vertex_texture_count);
+        block = grow_block(arrays->vertex_textures,
+                           capacity->vertex_texture_count * sizeof(vec2),
+                           s->counts.vertex_texture_count * sizeof(vec2),
+                           array_size(c, sizeof(vec2)));
+        if (block == NULL) {
+            return false;
+        }
+        arrays->vertex_textures = block;
+        capacity->vertex_texture_count = c;
+    }
+
+    if (needed.vertex_normal_count > capacity->vertex_normal_count) {
+        c = grown_capacity(capacity->vertex_normal_count,
+                           needed.vertex_normal_count);
+        block = grow_block(arrays->vertex_normals,
+                           capacity->vertex_normal_count * sizeof(point3),
+                           s->counts.vertex_normal_count * sizeof(point3),
+                           array_size(c, sizeof(point3)));
+        if (block == NULL) {
+            return false;
+        }
+        arrays->vertex_normals = block;
+        capacity->vertex_normal_count = c;
+    }
+
+    if (needed.face_count > capacity->face_count) {
+        c = grown_capacity(capacity->face_count, needed.face_count);
+        block = grow_block(arrays->faces,
+                           capacity->face_count * sizeof(obj_file_face), 0,
+                           array_size(c, sizeof(obj_file_face)));
+        if (block == NULL) {
+            return false;
+        }
+        arrays->faces = block;
+        capacity->face_count = c;
+    }
+    return true;
+}
+
+// room for vertex_count and face_count object elements. the cache arrays
+// are not copied, the object is dirty after every parse anyway. false when
+// the memory cannot grow for them
+static bool reserve_object(obj_stream *s, uint32_t vertex_count,
+                           uint32_t face_count) {
+    object *obj = &s->obj;
+    uint32_t c;
+    void *block;
+
+    if (vertex_count > s->vertex_capacity) {
+        c = grown_capacity(s->vertex_capacity, vertex_count);
+        block = grow_block(
+            obj->vertices, s->vertex_capacity * VERTEX_BLOCK_SIZE,
+            obj->vertex_count * sizeof(object_vertex),
+            array_size(c, VERTEX_BLOCK_SIZE));
+        if (block == NULL) {
+            return false;
+        }
+        obj->vertices = block;
+        s->vertex_capacity = c;
+    }
+
+    if (face_count > s->face_capacity) {
+        c = grown_capacity(s->face_capacity, face_count);
+        block = grow_block(obj->faces, s->face_capacity * FACE_BLOCK_SIZE,
+                           obj->face_count * sizeof(object_face),
+                           array_size(c, FACE_BLOCK_SIZE));
+        if (block == NULL) {
+            return false;
+        }
+        obj->faces = block;
+        s->face_capacity = c;
+    }
+
+    point_into_blocks(s);
+    return true;
+}
+
+// a block the stream allocated, and how much of it is still needed
+typedef struct {
+    uint8_t *block;
+    size_t size;
+    size_t used;
+} stream_block;
+
+// with the last line parsed only the object is needed. gives back the
+// blocks on top of the bump heap for as long as there are any, and the
+// unused end of the object blocks among them
+static void trim_stream(obj_stream *s) {
+    object *obj = &s->obj;
+    obj_counts *capacity = &s->capacity;
+
+    stream_block blocks[] = {
+        {(uint8_t *)obj->vertices, s->vertex_capacity * VERTEX_BLOCK_SIZE,
+         obj->vertex_count * VERTEX_BLOCK_SIZE},
+        {(uint8_t *)obj->faces, s->face_capacity * FACE_BLOCK_SIZE,
+         obj->face_count * FACE_BLOCK_SIZE},
+        {(uint8_t *)s->text, s->text_capacity, 0},
+        {(uint8_t *)s->arrays.vertices,
+         capacity->vertex_count * sizeof(point3), 0},
+        {(uint8_t *)s->arrays.vertex_textures,
+         capacity->vertex_texture_count * sizeof(vec2), 0},
+        {(uint8_t *)s->arrays.vertex_normals,
+         capacity->vertex_normal_count * sizeof(point3), 0},
+        {(uint8_t *)s->arrays.faces,
+         capacity->face_count * sizeof(obj_file_face), 0},
+        {(uint8_t *)s->weld.corners, obj_weld_size(s->weld.capacity), 0},
+    };
+    uint32_t block_count = sizeof(blocks) / sizeof(blocks[0]);
+
+    for (uint32_t i = 0; i < block_count;) {
+        stream_block *b = &blocks[i];
+        if (b->block != NULL && b->size > b->used &&
+            b->block + b->size == bump_pointer) {
+            bump_pointer = b->block + b->used;
+            b->size = b->used;
+            i = 0;
+        } else {
+            ++i;
+        }
+    }
+
+    s->vertex_capacity = blocks[0].size / VERTEX_BLOCK_SIZE;
+    s->face_capacity = blocks[1].size / FACE_BLOCK_SIZE;
+    s->text = NULL;
+    s->text_capacity = 0;
+    s->arrays = (obj_arrays){0};
+    *capacity = (obj_counts){0};
+    s->weld = (obj_weld){0};
+
+    point_into_blocks(s);
+}
+
+// places the vertices from first_vertex on like obj_psr. vertices wait in
+// model space until there is an extent to scale them by
+static void place_stream(obj_stream *s, uint32_t first_vertex) {
+    object *obj = &s->obj;
+
+    for (size_t i = first_vertex; i < obj->vertex_count; ++i) {
+        s->min_y = fminf(obj->vertices[i].position.y, s->min_y);
+        s->max_y = fmaxf(obj->vertices[i].position.y, s->max_y);
+    }
+
+    if (!s->placed && s->max_y > s->min_y) {
+        point3 center_grav = {0};
+        for (size_t i = 0; i < obj->vertex_count; ++i) {
+            center_grav = vec3_add(center_grav, obj->vertices[i].position);
+        }
+        s->center = vec3_scalar_divide(center_grav, obj->vertex_count);
+        s->placed_height = s->max_y - s->min_y;
+        s->placed = 1;
+        first_vertex = 0;
+    }
+
+    first_vertex = s->placed ? first_vertex : obj->vertex_count;
+    float scale = s->placed ? obj->height / s->placed_height : 1;
+    place_obj(obj, first_vertex, s->center, scale, obj->position,
+              obj->rotation);
+}
+
+// with every vertex in, rescales about their center of gravity to what
+// obj_psr would have made of the whole object
+static void finish_stream(obj_stream *s) {
+    object *obj = &s->obj;
+    if (!s->placed) {
+        return;
+    }
+
+    point3 center_grav = {0};
+    for (size_t i = 0; i < obj->vertex_count; ++i) {
+        center_grav = vec3_add(center_grav, obj->vertices[i].position);
+    }
+    center_grav = vec3_scalar_divide(center_grav, obj->vertex_count);
 
+    float scale = s->placed_height / (s->max_y - s->min_y);
     for (size_t i = 0; i < obj->vertex_count; ++i) {
-        v = obj->vertices[i];
+        vec3 v = vec3_sub(obj->vertices[i].position, center_grav);
+        obj->vertices[i].position =
+            vec3_add(vec3_scalar_mult(v, scale), obj->position);
+    }
+    obj->dirty = 1;
+}
 
-        v = vec3_sub(v, center_grav);            // center
-        v = vec3_scalar_mult(v, height_adjust);  // scale
-        v = mat3_vec3_mult(roll_rotation, v);    // rotate
-        v = mat3_vec3_mult(pitch_rotation, v);   //
-        v = mat3_vec3_mult(yaw_rotation, v);     //
-        v = vec3_add(v, position);               // position
+// parses the complete lines among the n bytes just written to
+// obj_stream_buffer and what was left before them, all of it when last.
+// position, rotation and height must be set before the first call. may
+// grow the memory. 0 when the text is not an obj file or the memory cannot
+// grow for it
+uint32_t obj_stream_parse(obj_stream *s, uint32_t n, uint32_t last) {
+    object *obj = &s->obj;
+
+    s->text_size += n;
+
+    char *end = s->text + s->text_size;
+    char *lines_end = end;
+    if (!last) {
+        while (lines_end > s->text && lines_end[-1] != '\n') {
+            --lines_end;
+        }
+    }
 
-        obj->vertices[i] = v;
+    obj_counts first = s->counts;
+    obj_counts counts = obj_count_chunk(s->text, lines_end);
+    obj_counts total = {
+        .vertex_count = first.vertex_count + counts.vertex_count,
+        .vertex_texture_count =
+            first.vertex_texture_count + counts.vertex_texture_count,
+        .vertex_normal_count =
+            first.vertex_normal_count + counts.vertex_normal_count,
+        .face_count = counts.face_count,
+    };
+
+    if (!reserve_arrays(s, total)) {
+        return 0;
+    }
 
-        n = obj->vertex_normals[i];
+    obj_sink sink = obj_sink_for(&s->arrays);
+    if (obj_parse_chunk(s->text, lines_end, first, total, &sink) != NULL) {
+        return 0;
+    }
 
-        n = mat3_vec3_mult(roll_rotation, n);
-        n = mat3_vec3_mult(pitch_rotation, n);
-        n = mat3_vec3_mult(yaw_rotation, n);
+    s->counts = total;
+    s->counts.face_count = 0;
+
+    uint32_t first_vertex = obj->vertex_count;
+    uint32_t face_count = obj->face_count + counts.face_count;
+
+    if (counts.face_count > 0) {
+        // faces usually come after all the vertices they use. the object
+        // has at least as many vertices as the largest array, and a closed
+        // mesh about twice as many faces as positions, so the blocks start
+        // out close to their final size instead of doubling up to it
+        if (s->weld.corners == NULL) {
+            uint32_t n = largest_array(total);
+            if (!grow_weld(&s->weld, obj_weld_capacity(n)) ||
+                !reserve_object(
+                    s, n, grown_capacity(total.vertex_count, face_count))) {
+                return 0;
+            }
+        }
+        if (!reserve_object(s, obj->vertex_count, face_count) ||
+            !weld_into(&s->weld, s->arrays.faces, counts.face_count,
+                       obj->faces + obj->face_count) ||
+            !reserve_object(s, s->weld.count, face_count)) {
+            return 0;
+        }
+        obj_weld_vertices(&s->weld, first_vertex, &s->arrays, obj->vertices);
+    }
+
+    obj->vertex_count = s->weld.count;
+    obj->face_count = face_count;
+    obj->textured = total.vertex_texture_count > 0;
+
+    place_stream(s, first_vertex);
+
+    s->text_size = end - lines_end;
+    memmove(s->text, lines_end, s->text_size);
+
+    if (last) {
+        finish_stream(s);
+        trim_stream(s);
+    }
+    return 1;
+}
+
+// same as obj_stream_parse for a binary stl file. the header gives the
+// face count, so the face block is allocated once, and records are welded
+// as they arrive. the count is checked like stl_parse does, against the
+// file size js gave or else the largest file a 32 bit memory holds, and
+// allocating for it can still fail. normals are only needed by the smooth
+// shading modes and are worked out once the last face is in
+uint32_t stl_stream_parse(obj_stream *s, uint32_t n, uint32_t last) {
+    object *obj = &s->obj;
+
+    s->text_size += n;
+
+    const uint8_t *p = (const uint8_t *)s->text;
+    const uint8_t *end = p + s->text_size;
+
+    if (s->weld.corners == NULL) {
+        if (s->text_size < STL_HEADER_SIZE) {
+            return !last;
+        }
+        if (!stl_face_count(p, s->size > 0 ? s->size : UINT32_MAX,
+                            &s->stl_face_count)) {
+            return 0;
+        }
+        p += STL_HEADER_SIZE;
+
+        // closed meshes have about half as many positions as faces
+        uint32_t positions = s->stl_face_count / 2;
+        if (!grow_weld(&s->weld, obj_weld_capacity(positions)) ||
+            !reserve_object(s, positions, s->stl_face_count)) {
+            return 0;
+        }
+        obj->shading = SHADING_FLAT;
+    }
+
+    uint32_t face_count = (end - p) / STL_FACE_SIZE;
+    if (face_count > s->stl_face_count - obj->face_count) {
+        face_count = s->stl_face_count - obj->face_count;
+    }
+    if (last && obj->face_count + face_count < s->stl_face_count) {
+        return 0;
+    }
 
-        obj->vertex_normals[i] = n;
+    uint32_t first_vertex = obj->vertex_count;
+    if (!stl_weld_into(&s->weld, p, face_count, obj->faces + obj->face_count) ||
+        !reserve_object(s, s->weld.count, s->stl_face_count)) {
+        return 0;
     }
+    stl_weld_vertices(&s->weld, first_vertex, obj->vertices);
+
+    obj->vertex_count = s->weld.count;
+    obj->face_count += face_count;
+
+    place_stream(s, first_vertex);
+
+    p += (size_t)face_count * STL_FACE_SIZE;
+    s->text_size = end - p;
+    memmove(s->text, p, s->text_size);
+
+    if (last) {
+        finish_stream(s);
+        stl_vertex_normals(obj);
+        trim_stream(s);
+    }
+    return 1;
+}
+
+camera cam = {0};
+// a light's camera, for its depth alone, see rasterize_obj_depth
+camera light_cam = {0};
+
+// framebuffer_occluded for js, which cannot pass structs. the box is
+// clipped to the framebuffer, nothing is occluded in an empty one, and the
+// depth is that of x, y, z from c, the camera fb was drawn from
+uint32_t camera_occluded(const framebuffer *fb, const camera *c, int32_t x0,
+                         int32_t y0, int32_t x1, int32_t y1, float x, float y,
+                         float z) {
+    vec2i bbox_min = {x0 > 0 ? x0 : 0, y0 > 0 ? y0 : 0};
+    vec2i bbox_max = {x1 < (int32_t)fb->width ? x1 : (int32_t)fb->width,
+                      y1 < (int32_t)fb->height ? y1 : (int32_t)fb->height};
+    if (bbox_min.x >= bbox_max.x || bbox_min.y >= bbox_max.y) {
+        return 0;
+    }
+    return framebuffer_occluded(fb, bbox_min, bbox_max,
+                                camera_depth(c, (point3){x, y, z}),
+                                c->depth_near, c->depth_far);
+}
+
+float test_func(camera *cam) { return cam->look_at.z; }
+
+// position, scale, & rotate
+// you must have set the position, rotation, and height
+// in the object before invoking
+void obj_psr(object *obj) {
+    position_and_scale_obj(obj, obj->position, obj->rotation, obj->height);
 }
 
 void obj_shift_by(object *obj, float sx, float sy, float sz) {
     vec3 shift = (vec3){sx, sy, sz};
 
-    for (size_t i = 0; i < obj->vertex_count; ++i) {
-        obj->vertices[i] = vec3_add(obj->vertices[i], shift);
+    if (obj->qvertices != NULL) {
+        mat3 identity = {{{1, 0, 0}, {0, 1, 0}, {0, 0, 1}}};
+        transform_quantized_obj(obj, identity, 1, (vec3){0, 0, 0}, shift);
+    } else {
+        for (size_t i = 0; i < obj->vertex_count; ++i) {
+            obj->vertices[i].position =
+                vec3_add(obj->vertices[i].position, shift);
+        }
     }
 
     obj->position = vec3_add(obj->position, shift);
+    obj->dirty = 1;
 }
 
 void obj_rotate_by(object *obj, float rx, float ry, float rz) {
@@ -127,9 +889,17 @@ void obj_rotate_by(object *obj, float rx, float ry, float rz) {
     }};
     // clang-format on
 
+    if (obj->qvertices != NULL) {
+        mat3 r =
+            mat3_mult(yaw_rotation, mat3_mult(pitch_rotation, roll_rotation));
+        transform_quantized_obj(obj, r, 1, position, position);
+        obj->rotation = vec3_add(rotation, (vec3){rx, ry, rz});
+        return;
+    }
+
     vec3 v, n;
     for (size_t i = 0; i < obj->vertex_count; ++i) {
-        v = obj->vertices[i];
+        v = obj->vertices[i].position;
 
         v = vec3_sub(v, position);
         v = mat3_vec3_mult(roll_rotation, v);
@@ -137,18 +907,19 @@ void obj_rotate_by(object *obj, float rx, float ry, float rz) {
         v = mat3_vec3_mult(yaw_rotation, v);
         v = vec3_add(v, position);
 
-        obj->vertices[i] = v;
+        obj->vertices[i].position = v;
 
-        n = obj->vertex_normals[i];
+        n = obj->vertices[i].normal;
 
         n = mat3_vec3_mult(roll_rotation, n);
         n = mat3_vec3_mult(pitch_rotation, n);
         n = mat3_vec3_mult(yaw_rotation, n);
 
-        obj->vertex_normals[i] = n;
+        obj->vertices[i].normal = n;
     }
 
     obj->rotation = vec3_add(rotation, (vec3){rx, ry, rz});
+    obj->dirty = 1;
 }
 
 void obj_set_position(object *obj, float x, float y, float z) {
@@ -160,3 +931,8 @@ void obj_set_rotation(object *obj, float x, float y, float z) {
 }
 
 void obj_set_height(object *obj, float height) { obj->height = height; }
+
+void obj_set_shading(object *obj, uint32_t shading) {
+    obj->shading = shading;
+    obj->dirty = 1;
+}
@@ -0,0 +1,46 @@
+#include "sampler.h"
+
+static sampler_axis axis_create(uint32_t address_mode, float offset,
+                                float scale, int32_t size) {
+    sampler_axis a = {
+        .offset = offset,
+        .scale = scale,
+        .max = size - 1,
+        .below = 0,
+        .above = size - 1,
+    };
+
+    switch (address_mode) {
+        case SAMPLER_CLAMP:
+            // a period of 0 leaves t as is for the clamp
+            a.period = 0;
+            a.inv_period = 0;
+            a.limit = 1;
+            break;
+        case SAMPLER_MIRROR:
+            a.period = 2;
+            a.inv_period = 0.5f;
+            a.limit = 2;
+            break;
+        default:
+            a.period = 1;
+            a.inv_period = 1;
+            a.limit = 1;
+            a.below = size - 1;
+            a.above = 0;
+            break;
+    }
+    return a;
+}
+
+sampler sampler_create(texture_image *ti, uint32_t level,
+                       uint32_t address_mode) {
+    const texture_level *l = &ti->levels[level];
+    return (sampler){
+        .level = l,
+        .block_shift = ti->block_shift,
+        // col = width * f, row = height * (1 - f)
+        .u = axis_create(address_mode, l->width, -l->width, l->width),
+        .v = axis_create(address_mode, 0, l->height, l->height),
+    };
+}
@@ -0,0 +1,162 @@
+#ifndef SAMPLER_H
+#define SAMPLER_H
+
+#include <math.h>
+#include <stdint.h>
+
+#if defined(__wasm_simd128__)
+#include <wasm_simd128.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#include "texture.h"
+
+// address modes, what a fetch outside [0, 1] reads
+#define SAMPLER_WRAP 0    // repeat the texture
+#define SAMPLER_CLAMP 1   // repeat the edge texels
+#define SAMPLER_MIRROR 2  // repeat the texture flipped every other time
+
+// filters
+#define SAMPLER_NEAREST 0
+#define SAMPLER_BILINEAR 1  // blend the 2x2 texels around the sample
+
+// the address mode is folded into period and limit so a fetch runs the same
+// instructions for every mode:
+//     f = clamp(u - period * floor(u / period), 0, limit)
+// lands in [0, 1] for wrap and clamp and in [0, 2] for mirror, and
+// |1 - f| folds the mirrored half back. the texel coordinate is then
+// offset + scale * |1 - f|, which also flips v so row 0 is the top
+typedef struct {
+    float period, inv_period, limit;
+    float offset, scale;
+    int32_t max;
+
+    // where the bilinear neighbours of the first and last texel land
+    int32_t below, above;
+} sampler_axis;
+
+// samples rgba8 texels, one uint32_t each
+typedef struct {
+    const texture_level *level;
+    uint32_t block_shift;
+
+    sampler_axis u, v;
+} sampler;
+
+sampler sampler_create(texture_image *ti, uint32_t level,
+                       uint32_t address_mode);
+
+static inline float sampler_axis_coord(const sampler_axis *a, float t) {
+    float f = t - a->period * floorf(t * a->inv_period);
+    f = fminf(fmaxf(f, 0), a->limit);
+    return a->offset + a->scale * fabsf(1 - f);
+}
+
+static inline uint32_t sampler_texel(const sampler *s, uint32_t row,
+                                     uint32_t col) {
+    const uint32_t *image = (const uint32_t *)s->level->image;
+    return image[texel_offset(s->level, s->block_shift, row, col)];
+}
+
+// texel nearest to (u, v)
+static inline uint32_t sampler_fetch_nearest(const sampler *s, float u,
+                                             float v) {
+    int32_t col = sampler_axis_coord(&s->u, u);
+    int32_t row = sampler_axis_coord(&s->v, v);
+    col = col < s->u.max ? col : s->u.max;
+    row = row < s->v.max ? row : s->v.max;
+    return sampler_texel(s, row, col);
+}
+
+// texel centers are at + 0.5, so the footprint starts half a texel back.
+// returns the first texel and the weight of the second one in 1 / 256ths
+static inline int32_t sampler_axis_footprint(const sampler_axis *a, float t,
+                                             int32_t *second,
+                                             uint32_t *weight) {
+    float c = sampler_axis_coord(a, t) - 0.5f;
+    float first = floorf(c);
+    int32_t i = first;
+
+    *weight = (c - first) * 256;
+    *second = i + 1 > a->max ? a->above : i + 1;
+    return i < 0 ? a->below : i;
+}
+
+// 2x2 footprint as packed rgba8 in one register, widened to 16 bit lanes
+// and blended with 8.8 fixed point weights, first along u then along v.
+// every product fits 16 bits since the weights of a lerp sum to 256
+static inline uint32_t sampler_fetch_bilinear(const sampler *s, float u,
+                                              float v) {
+    int32_t col1, row1;
+    uint32_t wx, wy;
+    int32_t col0 = sampler_axis_footprint(&s->u, u, &col1, &wx);
+    int32_t row0 = sampler_axis_footprint(&s->v, v, &row1, &wy);
+
+    uint32_t p00 = sampler_texel(s, row0, col0);
+    uint32_t p01 = sampler_texel(s, row0, col1);
+    uint32_t p10 = sampler_texel(s, row1, col0);
+    uint32_t p11 = sampler_texel(s, row1, col1);
+
+#if defined(__wasm_simd128__)
+    v128_t p = wasm_i32x4_make(p00, p01, p10, p11);
+    v128_t top = wasm_u16x8_extend_low_u8x16(p);
+    v128_t bottom = wasm_u16x8_extend_high_u8x16(p);
+
+    v128_t wx8 = wasm_i16x8_make(256 - wx, 256 - wx, 256 - wx, 256 - wx, wx,
+                                 wx, wx, wx);
+    top = wasm_i16x8_mul(top, wx8);
+    bottom = wasm_i16x8_mul(bottom, wx8);
+
+    // rows = {top row, bottom row}
+    v128_t rows = wasm_i16x8_add(
+        wasm_i16x8_shuffle(top, bottom, 0, 1, 2, 3, 8, 9, 10, 11),
+        wasm_i16x8_shuffle(top, bottom, 4, 5, 6, 7, 12, 13, 14, 15));
+    rows = wasm_u16x8_shr(wasm_i16x8_add(rows, wasm_i16x8_splat(128)), 8);
+
+    v128_t wy8 = wasm_i16x8_make(256 - wy, 256 - wy, 256 - wy, 256 - wy, wy,
+                                 wy, wy, wy);
+    rows = wasm_i16x8_mul(rows, wy8);
+    v128_t texel = wasm_i16x8_add(
+        rows, wasm_i16x8_shuffle(rows, rows, 4, 5, 6, 7, 0, 1, 2, 3));
+    texel = wasm_u16x8_shr(wasm_i16x8_add(texel, wasm_i16x8_splat(128)), 8);
+
+    return wasm_i32x4_extract_lane(wasm_u8x16_narrow_i16x8(texel, texel), 0);
+#elif defined(__SSE2__)
+    __m128i zero = _mm_setzero_si128();
+    __m128i p = _mm_set_epi32(p11, p10, p01, p00);
+    __m128i top = _mm_unpacklo_epi8(p, zero);
+    __m128i bottom = _mm_unpackhi_epi8(p, zero);
+
+    __m128i wx8 = _mm_set_epi16(wx, wx, wx, wx, 256 - wx, 256 - wx, 256 - wx,
+                                256 - wx);
+    top = _mm_mullo_epi16(top, wx8);
+    bottom = _mm_mullo_epi16(bottom, wx8);
+
+    __m128i rows = _mm_add_epi16(_mm_unpacklo_epi64(top, bottom),
+                                 _mm_unpackhi_epi64(top, bottom));
+    rows = _mm_srli_epi16(_mm_add_epi16(rows, _mm_set1_epi16(128)), 8);
+
+    __m128i wy8 = _mm_set_epi16(wy, wy, wy, wy, 256 - wy, 256 - wy, 256 - wy,
+                                256 - wy);
+    rows = _mm_mullo_epi16(rows, wy8);
+    __m128i texel = _mm_add_epi16(rows, _mm_srli_si128(rows, 8));
+    texel = _mm_srli_epi16(_mm_add_epi16(texel, _mm_set1_epi16(128)), 8);
+
+    return _mm_cvtsi128_si32(_mm_packus_epi16(texel, texel));
+#else
+    uint32_t texel = 0;
+    for (uint32_t shift = 0; shift < 32; shift += 8) {
+        uint32_t top = (((p00 >> shift) & 0xff) * (256 - wx) +
+                        ((p01 >> shift) & 0xff) * wx + 128) >>
+                       8;
+        uint32_t bottom = (((p10 >> shift) & 0xff) * (256 - wx) +
+                           ((p11 >> shift) & 0xff) * wx + 128) >>
+                          8;
+        texel |= ((top * (256 - wy) + bottom * wy + 128) >> 8) << shift;
+    }
+    return texel;
+#endif
+}
+
+#endif  // SAMPLER_H
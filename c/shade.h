@@ -0,0 +1,44 @@
+#ifndef SHADE_H
+#define SHADE_H
+
+#include <stdint.h>
+
+#if defined(__wasm_simd128__)
+#include <wasm_simd128.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+// 8 bit fixed point shading on packed rgba8 pixels, r in the low byte.
+// an intensity of 1 is 256, which keeps every channel product within 16
+// bits and lands within 1 of the float math truncated to a byte
+
+#define SHADE_ONE 256
+
+// intensities past 1 saturate
+static inline uint32_t shade_quantize(float intensity) {
+    float q = intensity * SHADE_ONE + 0.5f;
+    return q < SHADE_ONE ? (uint32_t)q : SHADE_ONE;
+}
+
+// texel * intensity per channel, with alpha forced to 255
+static inline uint32_t shade_modulate(uint32_t texel, uint32_t intensity) {
+#if defined(__wasm_simd128__)
+    v128_t c = wasm_u16x8_extend_low_u8x16(wasm_i32x4_splat(texel));
+    c = wasm_u16x8_shr(wasm_i16x8_mul(c, wasm_i16x8_splat(intensity)), 8);
+    texel = wasm_i32x4_extract_lane(wasm_u8x16_narrow_i16x8(c, c), 0);
+#elif defined(__SSE2__)
+    __m128i c =
+        _mm_unpacklo_epi8(_mm_cvtsi32_si128(texel), _mm_setzero_si128());
+    c = _mm_srli_epi16(_mm_mullo_epi16(c, _mm_set1_epi16(intensity)), 8);
+    texel = _mm_cvtsi128_si32(_mm_packus_epi16(c, c));
+#else
+    // r and b, then g and a, as two 16 bit lanes in a uint32_t
+    uint32_t rb = ((texel & 0x00ff00ff) * intensity >> 8) & 0x00ff00ff;
+    uint32_t ga = ((texel >> 8) & 0x00ff00ff) * intensity & 0xff00ff00;
+    texel = rb | ga;
+#endif
+    return texel | 0xff000000;
+}
+
+#endif  // SHADE_H
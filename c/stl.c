@@ -0,0 +1,96 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include "stl.h"
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "camera.h"
+#include "obj_parse.h"
+#include "stl_parse.h"
+
+// welds every face into out. closed meshes have about half as many
+// positions as faces, the table starts there and doubles when it fills up
+static obj_weld weld_faces(const uint8_t *records, uint32_t face_count,
+                           object_face *out) {
+    obj_weld weld = {0};
+    uint32_t k = 0;
+    do {
+        uint32_t capacity = weld.corners == NULL
+                                ? obj_weld_capacity(face_count / 2)
+                                : 2 * weld.capacity;
+        void *block = malloc(obj_weld_size(capacity));
+        if (block == NULL) {
+            fprintf(stderr, "error malloc stl weld table\n");
+            exit(1);
+        }
+        obj_weld grown =
+            obj_weld_from(block, capacity, weld.corners != NULL ? &weld : NULL);
+        free(weld.corners);
+        weld = grown;
+
+        k += stl_weld_faces(&weld, records + (size_t)k * STL_FACE_SIZE,
+                            face_count - k, out + k);
+    } while (k < face_count);
+
+    return weld;
+}
+
+object STL_read_file(const char *stl_filepath) {
+    int fd = open(stl_filepath, O_RDONLY);
+    struct stat st;
+    if (fd < 0 || fstat(fd, &st) != 0) {
+        fprintf(stderr, "error reading stl file: %s\n", stl_filepath);
+        exit(1);
+    }
+
+    size_t map_size = st.st_size;
+    uint8_t *map = NULL;
+    if (map_size > 0) {
+        map = (uint8_t *)mmap(NULL, map_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (map == MAP_FAILED) {
+            close(fd);
+            fprintf(stderr, "error mapping stl file: %s\n", stl_filepath);
+            exit(1);
+        }
+    }
+    close(fd);
+
+    uint32_t face_count;
+    if (!stl_face_count(map, map_size, &face_count)) {
+        fprintf(stderr, "error stl file too short: %s\n", stl_filepath);
+        exit(1);
+    }
+
+    object_face *faces =
+        (object_face *)malloc(face_count * sizeof(object_face));
+    if (faces == NULL) {
+        fprintf(stderr, "error malloc stl faces\n");
+        exit(1);
+    }
+
+    obj_weld weld = weld_faces(map + STL_HEADER_SIZE, face_count, faces);
+    munmap(map, map_size);
+
+    void *arena = malloc(obj_arena_size(weld.count, face_count));
+    if (arena == NULL) {
+        fprintf(stderr, "error malloc stl arena\n");
+        exit(1);
+    }
+
+    object obj = obj_from_arena(arena, weld.count, face_count);
+    memcpy(obj.faces, faces, face_count * sizeof(object_face));
+    stl_weld_vertices(&weld, 0, obj.vertices);
+    stl_vertex_normals(&obj);
+    obj.shading = SHADING_FLAT;
+
+    free(weld.corners);
+    free(faces);
+
+    return obj;
+}
@@ -0,0 +1,10 @@
+#ifndef STL_H
+#define STL_H
+
+#include "obj.h"
+
+// reads a binary stl file into an object with its positions welded, see
+// stl_parse.h. flat shaded, free it with OBJ_destroy
+object STL_read_file(const char *stl_filepath);
+
+#endif  // STL_H
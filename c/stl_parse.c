@@ -0,0 +1,73 @@
+#include "stl_parse.h"
+
+#include <string.h>
+
+bool stl_face_count(const uint8_t *bytes, size_t size, uint32_t *face_count) {
+    if (size < STL_HEADER_SIZE) {
+        return false;
+    }
+    memcpy(face_count, bytes + 80, sizeof(*face_count));
+    return (size - STL_HEADER_SIZE) / STL_FACE_SIZE >= *face_count;
+}
+
+// stl is z up. swapping y and z makes it y up, and mirroring x keeps the
+// faces winding counter clockwise. -0 becomes 0 so both weld together
+static inline obj_corner position_corner(const uint8_t *p) {
+    float f[3];
+    memcpy(f, p, sizeof(f));
+
+    float position[3] = {-f[0] + 0.0f, f[2] + 0.0f, f[1] + 0.0f};
+    obj_corner c;
+    memcpy(&c, position, sizeof(c));
+    return c;
+}
+
+uint32_t stl_weld_faces(obj_weld *weld, const uint8_t *records,
+                        uint32_t face_count, object_face *out) {
+    uint32_t k = 0;
+    for (; k < face_count && weld->count + 3 <= weld->capacity; ++k) {
+        // the normal is skipped, files often leave it 0
+        const uint8_t *vertices = records + k * STL_FACE_SIZE + 12;
+        for (int h = 0; h < 3; ++h) {
+            out[k].vertex_idxs[h] =
+                obj_weld_corner(weld, position_corner(vertices + h * 12));
+        }
+    }
+    return k;
+}
+
+void stl_weld_vertices(const obj_weld *weld, uint32_t first,
+                       object_vertex *out) {
+    for (uint32_t i = first; i < weld->count; ++i) {
+        out[i] = (object_vertex){0};
+        memcpy(&out[i].position, &weld->corners[i], sizeof(point3));
+    }
+}
+
+void stl_vertex_normals(object *obj) {
+    object_vertex *vertices = obj->vertices;
+    for (uint32_t i = 0; i < obj->vertex_count; ++i) {
+        vertices[i].normal = (vec3){0};
+    }
+
+    // the cross product is as long as twice the face's area
+    for (uint32_t k = 0; k < obj->face_count; ++k) {
+        object_face f = obj->faces[k];
+        point3 v1 = vertices[f.vertex_idxs[0]].position;
+        point3 v2 = vertices[f.vertex_idxs[1]].position;
+        point3 v3 = vertices[f.vertex_idxs[2]].position;
+
+        vec3 n = vec3_cross(vec3_sub(v2, v1), vec3_sub(v3, v1));
+        for (int h = 0; h < 3; ++h) {
+            object_vertex *v = &vertices[f.vertex_idxs[h]];
+            v->normal = vec3_add(v->normal, n);
+        }
+    }
+
+    for (uint32_t i = 0; i < obj->vertex_count; ++i) {
+        float length = vec3_length(vertices[i].normal);
+        if (length > 0) {
+            vertices[i].normal = vec3_scalar_divide(vertices[i].normal, length);
+        }
+    }
+}
@@ -0,0 +1,36 @@
+#ifndef STL_PARSE_H
+#define STL_PARSE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "obj.h"
+#include "obj_parse.h"
+
+// binary stl is an 80 byte header, a face count and then a record per face:
+// a normal, three vertices and two attribute bytes, little endian. faces
+// are welded with the obj weld table, keyed by the bits of the position
+// instead of v/vt/vn, so faces meeting at a position share its vertex.
+// nothing here allocates
+#define STL_HEADER_SIZE 84
+#define STL_FACE_SIZE 50
+
+// face count of the file, false when it is too short for them
+bool stl_face_count(const uint8_t *bytes, size_t size, uint32_t *face_count);
+
+// welds face_count records into out, stopping early when the next face
+// might not fit. returns how many faces it welded
+uint32_t stl_weld_faces(obj_weld *weld, const uint8_t *records,
+                        uint32_t face_count, object_face *out);
+
+// object vertices first up to weld->count at the welded positions. stl
+// has no texture coordinates, they are all 0, 0, and the normals are left
+// for stl_vertex_normals
+void stl_weld_vertices(const obj_weld *weld, uint32_t first,
+                       object_vertex *out);
+
+// vertex normals from the area weighted normals of the faces around them
+void stl_vertex_normals(object *obj);
+
+#endif  // STL_PARSE_H
@@ -1,6 +1,11 @@
+#include <math.h>
 #include <stdio.h>
+#include <stdlib.h>
 
-#include "rasterizer.h"
+#include "framebuffer.h"
+#include "obj_parse.h"
+#include "raster_kernel.h"
+#include "sampler.h"
 
 #define ASSERT_EQ(expected, actual)                                     \
     if ((expected) != (actual)) {                                       \
@@ -9,7 +14,291 @@
         exit(1);                                                        \
     }
 
+#define ASSERT_NEAR(expected, actual, tolerance)                         \
+    if (!(fabsf((expected) - (actual)) <= (tolerance))) {                \
+        printf("Test failed: %s != %s within %s, at %s:%d\n", #expected, \
+               #actual, #tolerance, __FILE__, __LINE__);                 \
+        exit(1);                                                         \
+    }
+
+// 4x4 rgba8 texture, row major, the red channel of each texel holds
+// row * 4 + col
+static uint32_t texels[16];
+
+static texture_image test_texture(void) {
+    for (int i = 0; i < 16; i++) texels[i] = i;
+
+    texture_image ti = {
+        .image_width = 4,
+        .image_height = 4,
+        .image_channels = 4,
+        .image = (uint8_t *)texels,
+        .block_shift = 0,
+        .level_count = 1,
+    };
+    ti.levels[0] = (texture_level){
+        .width = 4, .height = 4, .image = (uint8_t *)texels, .blocks_x = 4};
+    return ti;
+}
+
+static int fetch_filtered(uint32_t address_mode, uint32_t filter, float u,
+                          float v) {
+    texture_image ti = test_texture();
+    sampler s = sampler_create(&ti, 0, address_mode);
+    uint32_t texel = filter == SAMPLER_BILINEAR
+                         ? sampler_fetch_bilinear(&s, u, v)
+                         : sampler_fetch_nearest(&s, u, v);
+    return texel & 0xff;
+}
+
+static int fetch(uint32_t address_mode, float u, float v) {
+    return fetch_filtered(address_mode, SAMPLER_NEAREST, u, v);
+}
+
+// v = 1 is the top row, v = 0 just past the bottom one
+static void test_sampler_edges(void) {
+    ASSERT_EQ(0 * 4 + 0, fetch(SAMPLER_WRAP, 0, 0.99f));
+    ASSERT_EQ(3 * 4 + 3, fetch(SAMPLER_WRAP, 0.99f, 0.01f));
+    ASSERT_EQ(0 * 4 + 0, fetch(SAMPLER_WRAP, 1, 0.99f));
+    ASSERT_EQ(0 * 4 + 3, fetch(SAMPLER_WRAP, -0.125f, 0.99f));
+    ASSERT_EQ(3 * 4 + 0, fetch(SAMPLER_WRAP, 0.125f, 1.125f));
+
+    ASSERT_EQ(0 * 4 + 0, fetch(SAMPLER_CLAMP, -0.5f, 1.5f));
+    ASSERT_EQ(3 * 4 + 3, fetch(SAMPLER_CLAMP, 1.5f, -0.5f));
+    ASSERT_EQ(0 * 4 + 3, fetch(SAMPLER_CLAMP, 1, 1));
+    ASSERT_EQ(3 * 4 + 0, fetch(SAMPLER_CLAMP, 0, 0));
+
+    ASSERT_EQ(0 * 4 + 3, fetch(SAMPLER_MIRROR, 1.125f, 0.99f));
+    ASSERT_EQ(0 * 4 + 0, fetch(SAMPLER_MIRROR, -0.125f, 0.99f));
+    ASSERT_EQ(0 * 4 + 1, fetch(SAMPLER_MIRROR, 1.625f, 0.99f));
+    ASSERT_EQ(0 * 4 + 0, fetch(SAMPLER_MIRROR, 0.125f, 1.125f));
+    ASSERT_EQ(3 * 4 + 0, fetch(SAMPLER_MIRROR, 0.125f, -0.125f));
+
+    // u = 0 is on the left edge between the first texel and the one before
+    // it, v = 0.875 the center of the top row. wrap blends in the last
+    // texel of the row, clamp and mirror repeat the first
+    ASSERT_EQ(2, fetch_filtered(SAMPLER_WRAP, SAMPLER_BILINEAR, 0, 0.875f));
+    ASSERT_EQ(0, fetch_filtered(SAMPLER_CLAMP, SAMPLER_BILINEAR, 0, 0.875f));
+    ASSERT_EQ(0, fetch_filtered(SAMPLER_MIRROR, SAMPLER_BILINEAR, 0, 0.875f));
+}
+
+// one 16x16 tile, 4 samples per pixel
+static void test_msaa_resolve(void) {
+    static uint8_t image[16 * 16 * 4];
+    static float z_buffer[16 * 16 * FRAMEBUFFER_MSAA_SAMPLES];
+    static uint32_t sample_colors[16 * 16 * FRAMEBUFFER_MSAA_SAMPLES];
+    static uint8_t tile_cleared[1];
+
+    framebuffer fb = {
+        .width = 16,
+        .height = 16,
+        .channels = 4,
+        .tiles_x = 1,
+        .tiles_y = 1,
+        .image = image,
+        .z_buffer = z_buffer,
+        .tile_cleared = tile_cleared,
+        .samples = FRAMEBUFFER_MSAA_SAMPLES,
+        .sample_colors = sample_colors,
+    };
+    framebuffer_clear(&fb);
+    framebuffer_touch(&fb, (vec2i){0, 0}, (vec2i){16, 16});
+
+    // pixel 0 is half covered, pixel 1 fully
+    uint32_t color = 0xff204080;
+    sample_colors[0] = sample_colors[2] = color;
+    for (int i = 4; i < 8; i++) sample_colors[i] = color;
+
+    framebuffer_resolve(&fb);
+
+    // the half covered pixel keeps its color and fades out through alpha
+    uint32_t *pixels = (uint32_t *)image;
+    ASSERT_EQ(0x7f204080u, pixels[0]);
+    ASSERT_EQ(color, pixels[1]);
+    ASSERT_EQ(0u, pixels[2]);
+}
+
+// the stored depth of pixel 1,1 after a flat triangle over one 16x16 tile
+// at distance along the view, with the depth range 1..9
+static uint32_t draw_depth(uint32_t depth_format, float distance) {
+    static uint8_t image[16 * 16 * 4];
+    static uint32_t z_buffer[16 * 16];
+    static uint8_t tile_cleared[1];
+
+    framebuffer fb = {
+        .width = 16,
+        .height = 16,
+        .channels = 4,
+        .tiles_x = 1,
+        .tiles_y = 1,
+        .image = image,
+        .z_buffer = z_buffer,
+        .tile_cleared = tile_cleared,
+        .samples = 1,
+        .depth_format = depth_format,
+    };
+    raster_triangle t = {
+        .p1 = {0, 0},
+        .p2 = {0, 15},
+        .p3 = {15, 0},
+        .setup = {.bbox_min = {0, 0}, .bbox_max = {15, 15}},
+        .z = {-distance, -distance, -distance},
+        .depth_near = 1,
+        .depth_far = 9,
+        .intensities = {1, 1, 1},
+        .color = 0xffffffff,
+    };
+    framebuffer_clear(&fb);
+    framebuffer_touch(&fb, t.setup.bbox_min, t.setup.bbox_max);
+    raster_kernel_select(depth_format << RASTER_DEPTH_SHIFT)(&fb, &t);
+
+    ASSERT_EQ(0xffffffffu, ((uint32_t *)image)[16 + 1]);
+    return depth_format == DEPTH_UNORM16 ? ((uint16_t *)z_buffer)[16 + 1]
+                                         : z_buffer[16 + 1];
+}
+
+// depth_near stores the largest value and depth_far 0, clamping past them,
+// and the middle of the range lands within one unit of the middle
+static void test_integer_depth_range(void) {
+    uint32_t formats[] = {DEPTH_UNORM16, DEPTH_UNORM24};
+    uint32_t maxes[] = {DEPTH_UNORM16_MAX, DEPTH_UNORM24_MAX};
+    for (int i = 0; i < 2; i++) {
+        ASSERT_EQ(maxes[i], draw_depth(formats[i], 1));
+        ASSERT_EQ(maxes[i], draw_depth(formats[i], 0.5f));
+        ASSERT_EQ(0u, draw_depth(formats[i], 9));
+        ASSERT_EQ(0u, draw_depth(formats[i], 20));
+        ASSERT_NEAR(maxes[i] / 2.f, (float)draw_depth(formats[i], 5), 1);
+    }
+}
+
+// one 16x16 tile with one sample a pixel, float depth
+typedef struct {
+    uint8_t image[16 * 16 * 4];
+    float z_buffer[16 * 16];
+    uint8_t tile_cleared[1];
+    framebuffer fb;
+} test_tile;
+
+static void test_tile_clear(test_tile *tile) {
+    tile->fb = (framebuffer){
+        .width = 16,
+        .height = 16,
+        .channels = 4,
+        .tiles_x = 1,
+        .tiles_y = 1,
+        .image = tile->image,
+        .z_buffer = tile->z_buffer,
+        .tile_cleared = tile->tile_cleared,
+        .samples = 1,
+    };
+    framebuffer_clear(&tile->fb);
+    framebuffer_touch(&tile->fb, (vec2i){0, 0}, (vec2i){16, 16});
+}
+
+// a triangle lit over part of its area, through its intensities or its
+// normals. the depth only kernel with RASTER_LIT_ONLY writes depth at the
+// pixels the shading kernel colors and nowhere else
+static void test_lit_only_depth(void) {
+    static test_tile color, depth;
+    raster_triangle t = {
+        .p1 = {0, 0},
+        .p2 = {0, 15},
+        .p3 = {15, 0},
+        .setup = {.bbox_min = {0, 0}, .bbox_max = {15, 15}},
+        .z = {-2, -3, -4},
+        .depth_near = 0,
+        .depth_far = 10,
+        .inv_w = {0.5f, 1 / 3.f, 0.25f},
+        .intensities = {1, -1, 0.3f},
+        .n1 = {0, 0, 1},
+        .n2 = {0, 0, -1},
+        .n3 = {0.6f, 0, 0.8f},
+        .light_dir = {0, 0, -1},
+        .color = 0xffffffff,
+    };
+
+    uint32_t lightings[] = {0, RASTER_PIXEL_LIGHTING};
+    for (int l = 0; l < 2; l++) {
+        test_tile_clear(&color);
+        test_tile_clear(&depth);
+        raster_kernel_select(lightings[l])(&color.fb, &t);
+        raster_depth_kernel_select(lightings[l] | RASTER_LIT_ONLY)(&depth.fb,
+                                                                   &t);
+
+        int lit = 0;
+        for (int i = 0; i < 16 * 16; i++) {
+            bool colored = ((uint32_t *)color.image)[i] != 0;
+            ASSERT_EQ(colored, depth.z_buffer[i] != -INFINITY);
+            lit += colored;
+        }
+
+        // without RASTER_LIT_ONLY the unlit part gets depth too
+        raster_depth_kernel_select(lightings[l])(&depth.fb, &t);
+        int covered = 0;
+        for (int i = 0; i < 16 * 16; i++) {
+            covered += depth.z_buffer[i] != -INFINITY;
+        }
+        ASSERT_EQ(true, lit > 0 && lit < covered);
+    }
+}
+
+// vertices spread over x in -3..5, y in 0..1 and a flat z, with unit
+// normals pointing every way and texture coordinates in 0.25..0.75
+static void test_dequantize_bound(void) {
+    enum { VERTEX_COUNT = 64 };
+    object obj = obj_from_arena(malloc(obj_arena_size(VERTEX_COUNT, 0)),
+                                VERTEX_COUNT, 0);
+
+    uint32_t seed = 1;
+    for (int i = 0; i < VERTEX_COUNT; i++) {
+        float r[5];
+        for (int k = 0; k < 5; k++) {
+            seed = seed * 1664525 + 1013904223;
+            r[k] = (seed >> 8) / 16777216.f;
+        }
+        vec3 n = {r[0] - 0.5f, r[1] - 0.5f, r[2] - 0.5f};
+        obj.vertices[i] = (object_vertex){
+            .position = {-3 + 8 * r[3], r[4], 2},
+            .normal = vec3_scalar_divide(n, vec3_length(n)),
+            .texture = {0.25f + 0.5f * r[3], 0.75f - 0.5f * r[4]},
+        };
+    }
+    obj.vertices[0].position = (point3){-3, 0, 2};
+    obj.vertices[1].position = (point3){5, 1, 2};
+
+    object q = obj_quantize(&obj, malloc(obj_quantized_size(VERTEX_COUNT, 0)));
+
+    // half a step of 16 bits over the extent, plus float rounding. the
+    // texture extents are at most 0.5, and the flat axis comes back exactly
+    float x_step = 4 / 32767.f, y_step = 0.5f / 32767;
+    float texture_step = 0.5f / 65535;
+    for (int i = 0; i < VERTEX_COUNT; i++) {
+        point3 p = object_position(&q, i);
+        vec3 n = object_normal(&q, i);
+        vec2 t = object_texture(&q, i);
+        const object_vertex *v = &obj.vertices[i];
+
+        ASSERT_NEAR(v->position.x, p.x, x_step / 2 + 1e-6f);
+        ASSERT_NEAR(v->position.y, p.y, y_step / 2 + 1e-6f);
+        ASSERT_EQ(v->position.z, p.z);
+        ASSERT_NEAR(v->normal.x, n.x, 1e-4f);
+        ASSERT_NEAR(v->normal.y, n.y, 1e-4f);
+        ASSERT_NEAR(v->normal.z, n.z, 1e-4f);
+        ASSERT_NEAR(v->texture.x, t.x, texture_step / 2 + 1e-6f);
+        ASSERT_NEAR(v->texture.y, t.y, texture_step / 2 + 1e-6f);
+    }
+
+    free(q.arena);
+    free(obj.arena);
+}
+
 int main(void) {
+    test_sampler_edges();
+    test_msaa_resolve();
+    test_dequantize_bound();
+    test_integer_depth_range();
+    test_lit_only_depth();
+
     printf("All tests passed!\n");
     return 0;
 }
@@ -3,15 +3,51 @@
 
 #include <stdint.h>
 
+#define TEXTURE_MAX_LEVELS 16
+
+// levels are stored in square blocks of 1 << block_shift texels per side,
+// block after block in row major order. 4x4 rgba blocks are one cache line,
+// a block_shift of 0 is the plain row major layout
+#define TEXTURE_BLOCK_SHIFT 2
+
+typedef struct {
+    int32_t width, height;
+
+    uint8_t *image;
+
+    // blocks per block row, width rounded up to whole blocks
+    uint32_t blocks_x;
+} texture_level;
+
 typedef struct {
     int32_t image_width, image_height, image_channels;
 
     uint8_t *image;
+
+    // SAMPLER_WRAP, SAMPLER_CLAMP or SAMPLER_MIRROR, see sampler.h
+    uint32_t address_mode;
+    // SAMPLER_NEAREST or SAMPLER_BILINEAR
+    uint32_t filter;
+
+    // mip chain, levels[0] holds image and every next level is half the size
+    // of the previous one, see mipmap.h
+    uint32_t block_shift;
+    uint32_t level_count;
+    texture_level levels[TEXTURE_MAX_LEVELS];
 } texture_image;
 
-texture_image read_texture_image_png(const char *filepath);
+// offset of texel (row, col) in a level, in texels
+static inline uint32_t texel_offset(const texture_level *level,
+                                    uint32_t block_shift, uint32_t row,
+                                    uint32_t col) {
+    uint32_t mask = (1u << block_shift) - 1;
+    uint32_t block =
+        (row >> block_shift) * level->blocks_x + (col >> block_shift);
+    return (block << (2 * block_shift)) + ((row & mask) << block_shift) +
+           (col & mask);
+}
 
-uint8_t *get_pixel_from_norm(texture_image *ti, float nx, float ny);
+texture_image read_texture_image_png(const char *filepath);
 
 void destroy_texture(texture_image *ti);
 
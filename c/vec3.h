@@ -4,7 +4,14 @@
 #include <math.h>
 #include <stdbool.h>
 #include <stdint.h>
+
+#if defined(__wasm_simd128__)
 #include <wasm_simd128.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#else
+#include <string.h>
+#endif
 
 #define PI 3.1415926535897932385f
 
@@ -177,10 +184,48 @@ static inline vec3 mat3_vec3_mult(mat3 A, vec3 b) {
     return v;
 }
 
+static inline mat3 mat3_mult(mat3 A, mat3 B) {
+    mat3 C;
+    for (int i = 0; i < 3; ++i) {
+        for (int j = 0; j < 3; ++j) {
+            C.e[i][j] = A.e[i][0] * B.e[0][j] + A.e[i][1] * B.e[1][j] +
+                        A.e[i][2] * B.e[2][j];
+        }
+    }
+    return C;
+}
+
 typedef struct {
     float x, y;
 } vec2;
 
+// unit vector to octahedral coordinates in -1..1 and back, two numbers
+// that quantize evenly over the sphere. 0, 0, 0 maps to 0, 0
+static inline vec2 vec3_to_octahedral(vec3 n) {
+    float sum = fabsf(n.x) + fabsf(n.y) + fabsf(n.z);
+    if (sum == 0) {
+        return (vec2){0, 0};
+    }
+    float x = n.x / sum, y = n.y / sum;
+    if (n.z < 0) {
+        float folded_x = (1 - fabsf(y)) * (x >= 0 ? 1 : -1);
+        y = (1 - fabsf(x)) * (y >= 0 ? 1 : -1);
+        x = folded_x;
+    }
+    return (vec2){x, y};
+}
+
+static inline vec3 octahedral_to_vec3(float x, float y) {
+    float z = 1 - fabsf(x) - fabsf(y);
+    if (z < 0) {
+        float folded_x = (1 - fabsf(y)) * (x >= 0 ? 1 : -1);
+        y = (1 - fabsf(x)) * (y >= 0 ? 1 : -1);
+        x = folded_x;
+    }
+    float inv_length = 1 / sqrtf(x * x + y * y + z * z);
+    return (vec3){x * inv_length, y * inv_length, z * inv_length};
+}
+
 static inline vec2 vec2_add3(vec2 v1, vec2 v2, vec2 v3) {
     return (vec2){
         .x = v1.x + v2.x + v3.x,
@@ -214,8 +259,14 @@ typedef struct {
     uint32_t *x, *y, *z;
 } vec3i_soa;
 
+#if defined(__wasm_simd128__)
 #define v_load wasm_v128_load
 #define v_store wasm_v128_store
+#define v_and wasm_v128_and
+#define v_any_true wasm_v128_any_true
+#define v_bitselect wasm_v128_bitselect
+#define vi_splat wasm_i32x4_splat
+#define vf_make wasm_f32x4_make
 #define vf_splat wasm_f32x4_splat
 #define vf_add wasm_f32x4_add
 #define vf_mul wasm_f32x4_mul
@@ -223,8 +274,201 @@ typedef struct {
 #define vf_div wasm_f32x4_div
 #define vf_max wasm_f32x4_max
 #define vf_min wasm_f32x4_min
+#define vf_ge wasm_f32x4_ge
+#define vf_sqrt wasm_f32x4_sqrt
 #define vf_shuffle wasm_v32x4_shuffle
 #define vf_ex_lane wasm_f32x4_extract_lane
+#define vi_trunc wasm_i32x4_trunc_sat_f32x4
+#define vi_ge wasm_i32x4_ge
+#define vi_load_u16x4 wasm_u32x4_load16x4
+#define vi_store_u16x4(p, v) \
+    wasm_v128_store64_lane((p), wasm_u16x8_narrow_i32x4((v), (v)), 0)
+#define v_bitmask wasm_i32x4_bitmask
+#elif defined(__SSE2__)
+// native builds. int lanes are kept in the float register type, only the
+// bitwise operations touch them. vf_shuffle takes lanes 0..3 of one vector
+typedef __m128 v128_t;
+
+#define v_load(p) _mm_loadu_ps((const float *)(p))
+#define v_store(p, v) _mm_storeu_ps((float *)(p), (v))
+#define v_and _mm_and_ps
+#define v_any_true(v) (_mm_movemask_ps(v) != 0)
+#define v_bitselect(a, b, mask) \
+    _mm_or_ps(_mm_and_ps((mask), (a)), _mm_andnot_ps((mask), (b)))
+#define vi_splat(i) _mm_castsi128_ps(_mm_set1_epi32(i))
+#define vf_make _mm_setr_ps
+#define vf_splat _mm_set1_ps
+#define vf_add _mm_add_ps
+#define vf_mul _mm_mul_ps
+#define vf_sub _mm_sub_ps
+#define vf_div _mm_div_ps
+#define vf_max _mm_max_ps
+#define vf_min _mm_min_ps
+#define vf_ge _mm_cmpge_ps
+#define vf_sqrt _mm_sqrt_ps
+#define vf_shuffle(a, b, i0, i1, i2, i3) \
+    _mm_shuffle_ps((a), (b), _MM_SHUFFLE(i3, i2, i1, i0))
+
+static inline float vf_ex_lane(v128_t v, int i) {
+    float lanes[4];
+    _mm_storeu_ps(lanes, v);
+    return lanes[i];
+}
+
+// saturating like wasm: nan lanes are zeroed first, and lanes at or above
+// 2^31, which cvttps turns into INT32_MIN, are flipped to INT32_MAX
+static inline v128_t vi_trunc(v128_t v) {
+    v = _mm_and_ps(v, _mm_cmpord_ps(v, v));
+    v128_t over = _mm_cmpge_ps(v, _mm_set1_ps(2147483648.0f));
+    return _mm_xor_ps(_mm_castsi128_ps(_mm_cvttps_epi32(v)), over);
+}
+
+#define v_bitmask(v) ((uint32_t)_mm_movemask_ps(v))
+
+static inline v128_t vi_ge(v128_t a, v128_t b) {
+    __m128i lt = _mm_cmplt_epi32(_mm_castps_si128(a), _mm_castps_si128(b));
+    return _mm_castsi128_ps(_mm_xor_si128(lt, _mm_set1_epi32(-1)));
+}
+
+// 4 uint16_t to and from int lanes, which hold 0..65535
+static inline v128_t vi_load_u16x4(const void *p) {
+    __m128i h = _mm_loadl_epi64((const __m128i *)p);
+    return _mm_castsi128_ps(_mm_unpacklo_epi16(h, _mm_setzero_si128()));
+}
+
+static inline void vi_store_u16x4(void *p, v128_t v) {
+    // packs saturates to int16, the sign extended low halves pack as is
+    __m128i i = _mm_srai_epi32(_mm_slli_epi32(_mm_castps_si128(v), 16), 16);
+    _mm_storel_epi64((__m128i *)p, _mm_packs_epi32(i, i));
+}
+#else
+// hosts with neither, one lane at a time with the same results as sse2.
+// vf_shuffle takes lanes 0..3 of one vector, like the sse2 one
+typedef union {
+    float f[4];
+    int32_t i[4];
+} v128_t;
+
+static inline v128_t v_load(const void *p) {
+    v128_t v;
+    memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+static inline void v_store(void *p, v128_t v) { memcpy(p, &v, sizeof(v)); }
+
+static inline v128_t vi_splat(int32_t a) { return (v128_t){.i = {a, a, a, a}}; }
+
+static inline v128_t vf_splat(float a) { return (v128_t){.f = {a, a, a, a}}; }
+
+static inline v128_t vf_make(float a, float b, float c, float d) {
+    return (v128_t){.f = {a, b, c, d}};
+}
+
+static inline v128_t v_and(v128_t a, v128_t b) {
+    for (int k = 0; k < 4; ++k) {
+        a.i[k] &= b.i[k];
+    }
+    return a;
+}
+
+static inline bool v_any_true(v128_t v) {
+    return (v.i[0] | v.i[1] | v.i[2] | v.i[3]) != 0;
+}
+
+static inline v128_t v_bitselect(v128_t a, v128_t b, v128_t mask) {
+    for (int k = 0; k < 4; ++k) {
+        a.i[k] = (a.i[k] & mask.i[k]) | (b.i[k] & ~mask.i[k]);
+    }
+    return a;
+}
+
+#define VF_LANEWISE(name, lane)                     \
+    static inline v128_t name(v128_t a, v128_t b) { \
+        v128_t r;                                   \
+        for (int k = 0; k < 4; ++k) {               \
+            float x = a.f[k], y = b.f[k];           \
+            r.f[k] = (lane);                        \
+        }                                           \
+        return r;                                   \
+    }
+
+VF_LANEWISE(vf_add, x + y)
+VF_LANEWISE(vf_mul, x * y)
+VF_LANEWISE(vf_sub, x - y)
+VF_LANEWISE(vf_div, x / y)
+VF_LANEWISE(vf_max, x > y ? x : y)
+VF_LANEWISE(vf_min, x < y ? x : y)
+
+static inline v128_t vf_ge(v128_t a, v128_t b) {
+    v128_t r;
+    for (int k = 0; k < 4; ++k) {
+        r.i[k] = a.f[k] >= b.f[k] ? -1 : 0;
+    }
+    return r;
+}
+
+static inline v128_t vf_shuffle(v128_t a, v128_t b, int i0, int i1, int i2,
+                                int i3) {
+    return (v128_t){.f = {a.f[i0], a.f[i1], b.f[i2], b.f[i3]}};
+}
+
+static inline float vf_ex_lane(v128_t v, int i) { return v.f[i]; }
+
+static inline v128_t vf_sqrt(v128_t a) {
+    for (int k = 0; k < 4; ++k) {
+        a.f[k] = sqrtf(a.f[k]);
+    }
+    return a;
+}
+
+static inline v128_t vi_trunc(v128_t a) {
+    v128_t r;
+    for (int k = 0; k < 4; ++k) {
+        float x = a.f[k];
+        if (x != x) {
+            r.i[k] = 0;
+        } else if (x >= 2147483648.0f) {
+            r.i[k] = INT32_MAX;
+        } else if (x <= -2147483648.0f) {
+            r.i[k] = INT32_MIN;
+        } else {
+            r.i[k] = (int32_t)x;
+        }
+    }
+    return r;
+}
+
+static inline uint32_t v_bitmask(v128_t v) {
+    uint32_t mask = 0;
+    for (int k = 0; k < 4; ++k) {
+        mask |= ((uint32_t)v.i[k] >> 31) << k;
+    }
+    return mask;
+}
+
+static inline v128_t vi_ge(v128_t a, v128_t b) {
+    v128_t r;
+    for (int k = 0; k < 4; ++k) {
+        r.i[k] = a.i[k] >= b.i[k] ? -1 : 0;
+    }
+    return r;
+}
+
+static inline v128_t vi_load_u16x4(const void *p) {
+    uint16_t h[4];
+    memcpy(h, p, sizeof(h));
+    return (v128_t){.i = {h[0], h[1], h[2], h[3]}};
+}
+
+static inline void vi_store_u16x4(void *p, v128_t v) {
+    uint16_t h[4];
+    for (int k = 0; k < 4; ++k) {
+        h[k] = (uint16_t)v.i[k];
+    }
+    memcpy(p, h, sizeof(h));
+}
+#endif
 
 static inline v128_t vf_add3(v128_t v1, v128_t v2, v128_t v3) {
     return vf_add(v1, vf_add(v2, v3));
@@ -269,6 +513,15 @@ static inline vec3v vec3v_from_vec3(vec3 v) {
     };
 }
 
+// lane i holds vi, for reading arrays of structs
+static inline vec3v vec3v_gather(vec3 v0, vec3 v1, vec3 v2, vec3 v3) {
+    return (vec3v){
+        .x = vf_make(v0.x, v1.x, v2.x, v3.x),
+        .y = vf_make(v0.y, v1.y, v2.y, v3.y),
+        .z = vf_make(v0.z, v1.z, v2.z, v3.z),
+    };
+}
+
 static inline vec3v vec3v_load(vec3_soa v, size_t i) {
     return (vec3v){
         .x = v_load(v.x + i),
@@ -332,6 +585,19 @@ static inline vec3v vec3v_scalar_div(vec3v v, float t) {
     };
 }
 
+static inline v128_t vec3v_dot(vec3v v1, vec3v v2) {
+    return vf_add(vf_add(vf_mul(v1.x, v2.x), vf_mul(v1.y, v2.y)),
+                  vf_mul(v1.z, v2.z));
+}
+
+static inline vec3v vec3v_cross(vec3v v1, vec3v v2) {
+    return (vec3v){
+        .x = vf_sub(vf_mul(v1.y, v2.z), vf_mul(v1.z, v2.y)),
+        .y = vf_sub(vf_mul(v1.z, v2.x), vf_mul(v1.x, v2.z)),
+        .z = vf_sub(vf_mul(v1.x, v2.y), vf_mul(v1.y, v2.x)),
+    };
+}
+
 static inline vec3v vec3v_h_add_splat(vec3v v) {
     return (vec3v){
         .x = vf_h_add_splat(v.x),
@@ -353,7 +619,7 @@ static inline mat3v new_mat3v(float a11, float a12, float a13,
         {vf_splat(a21), vf_splat(a22), vf_splat(a23)},
         {vf_splat(a31), vf_splat(a32), vf_splat(a33)},
     }};
-};
+}
 // clang-format on
 
 static inline vec3v mat3v_vec3v_mul(mat3v mat, vec3v vec) {
@@ -1,5 +0,0 @@
-class Entity {
-    objPtr;
-    texturePtr;
-}
-export {};
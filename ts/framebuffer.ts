@@ -0,0 +1,126 @@
+import * as utils from "./utils.js";
+import { Uint32, Allocator } from "./utils.js";
+
+export const FRAMEBUFFER_TILE_SIZE = 16;
+export const FRAMEBUFFER_MSAA_SAMPLES = 4;
+
+// how depth is stored, see framebuffer.h
+export enum DepthFormat {
+    Float32 = 0,
+    Unorm16 = 1,
+    Unorm24 = 2,
+}
+
+// bytes of one depth sample
+export const depthSize = (depthFormat: DepthFormat): number =>
+    depthFormat === DepthFormat.Unorm16 ? 2 : 4;
+
+export class FramebufferStruct {
+    readonly width: Uint32;
+    readonly height: Uint32;
+    readonly channels: Uint32;
+
+    readonly tilesX: Uint32;
+    readonly tilesY: Uint32;
+
+    readonly imagePtr: Uint32;
+    readonly zBufferPtr: Uint32;
+    readonly tileClearedPtr: Uint32;
+
+    readonly samples: Uint32;
+    readonly sampleColorsPtr: Uint32;
+
+    readonly depthFormat: Uint32;
+
+    readonly ptr: number;
+
+    constructor(view: DataView, malloc: Allocator) {
+        this.width = new Uint32(view, malloc);
+        this.height = new Uint32(view, malloc);
+        this.channels = new Uint32(view, malloc);
+
+        this.tilesX = new Uint32(view, malloc);
+        this.tilesY = new Uint32(view, malloc);
+
+        this.imagePtr = new Uint32(view, malloc);
+        this.zBufferPtr = new Uint32(view, malloc);
+        this.tileClearedPtr = new Uint32(view, malloc);
+
+        this.samples = new Uint32(view, malloc);
+        this.sampleColorsPtr = new Uint32(view, malloc);
+
+        this.depthFormat = new Uint32(view, malloc);
+
+        this.ptr = this.width.ptr;
+    }
+}
+
+// bytes allocateFramebuffer takes
+export const framebufferSize = (
+    width: number,
+    height: number,
+    channels: number,
+    samples = 1,
+    depthFormat = DepthFormat.Float32,
+): number => {
+    const tilesX = Math.ceil(width / FRAMEBUFFER_TILE_SIZE);
+    const tilesY = Math.ceil(height / FRAMEBUFFER_TILE_SIZE);
+    const sampleBytes = samples > 1 ? samples * utils.UINT32_SIZE : 0;
+
+    return (
+        11 * utils.UINT32_SIZE +
+        width *
+            height *
+            (channels * utils.UINT8_SIZE +
+                samples * depthSize(depthFormat) +
+                sampleBytes) +
+        tilesX * tilesY * utils.UINT8_SIZE
+    );
+};
+
+export const allocateFramebuffer = (
+    width: number,
+    height: number,
+    channels: number,
+    malloc: Allocator,
+    view: DataView,
+    samples = 1,
+    depthFormat = DepthFormat.Float32,
+): FramebufferStruct => {
+    const framebuffer = new FramebufferStruct(view, malloc);
+
+    const tilesX = Math.ceil(width / FRAMEBUFFER_TILE_SIZE);
+    const tilesY = Math.ceil(height / FRAMEBUFFER_TILE_SIZE);
+
+    framebuffer.width.write(width);
+    framebuffer.height.write(height);
+    framebuffer.channels.write(channels);
+
+    framebuffer.tilesX.write(tilesX);
+    framebuffer.tilesY.write(tilesY);
+
+    // contents are undefined until the first framebuffer_clear and
+    // framebuffer_resolve
+    framebuffer.imagePtr.write(
+        malloc(width * height * channels * utils.UINT8_SIZE),
+    );
+    framebuffer.zBufferPtr.write(
+        malloc(width * height * samples * depthSize(depthFormat)),
+    );
+    framebuffer.tileClearedPtr.write(
+        malloc(tilesX * tilesY * utils.UINT8_SIZE),
+    );
+
+    // 1 or FRAMEBUFFER_MSAA_SAMPLES, the sample colors are only there when
+    // multisampled
+    framebuffer.samples.write(samples);
+    framebuffer.sampleColorsPtr.write(
+        samples > 1 ? malloc(width * height * samples * utils.UINT32_SIZE) : 0,
+    );
+
+    // the integer formats spread the camera's depth range over theirs, see
+    // setCamera
+    framebuffer.depthFormat.write(depthFormat);
+
+    return framebuffer;
+};
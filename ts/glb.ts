@@ -0,0 +1,29 @@
+import { Allocator, UINT32_SIZE } from "./utils.js";
+
+// see glb_parse.h
+export const GLB_MAGIC = 0x46546c67;
+
+// glb files start with the magic
+export const isGLB = (bytes: ArrayBuffer): boolean =>
+    bytes.byteLength >= UINT32_SIZE &&
+    new DataView(bytes).getUint32(0, true) === GLB_MAGIC;
+
+// like parseSTL, except glb_parse can point the object into the copied
+// bytes when the buffers are laid out as the object arrays. the copy starts
+// 4 byte aligned so they can be. memory must have room for the bytes and
+// the 3 spare ones, glb_parse grows it for the object
+export const parseGLB = (
+    glbFile: Uint8Array,
+    malloc: Allocator,
+    memory: ArrayBuffer,
+    glbParse: (bytesPtr: number, size: number) => number,
+): number => {
+    const bytesPtr = (malloc(glbFile.length + 3) + 3) & ~3;
+    new Uint8Array(memory, bytesPtr, glbFile.length).set(glbFile);
+
+    const objPtr = glbParse(bytesPtr, glbFile.length);
+    if (objPtr === 0) {
+        throw new Error("invalid or too large glb file");
+    }
+    return objPtr;
+};
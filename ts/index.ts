@@ -1,14 +1,7 @@
 import { WasmRasterizer } from "./rasterizer.js";
-import { Vec3 } from "./utils.js";
+import { imageWidth, imageHeight, setupScene, updateScene } from "./scene.js";
 
-const imageWidth = 800;
-const imageHeight = 800;
-const imageChannels = 4;
-const vFov = 20.0;
-
-const wasmImportUrl = "./wasm/rasterizer.wasm";
-const objUrl = "./3d/head.obj";
-const textureUrl = "./img/head_texture_smol.png";
+const workerUrl = "./js/worker.js";
 
 const canvasId = "myCanvas";
 
@@ -17,45 +10,41 @@ const canvasId = "myCanvas";
     canvas.width = imageWidth;
     canvas.height = imageHeight;
 
+    // ?worker renders in a dedicated worker, see worker.ts. the page shows
+    // each frame it posts and then asks for the next one
+    if (new URLSearchParams(location.search).has("worker")) {
+        const bitmapCtx = canvas.getContext("bitmaprenderer");
+        if (bitmapCtx == null) {
+            throw new Error("bitmaprenderer canvas not supported");
+        }
+
+        const worker = new Worker(workerUrl, { type: "module" });
+        worker.addEventListener(
+            "message",
+            (event: MessageEvent<ImageBitmap>) => {
+                requestAnimationFrame(() => {
+                    bitmapCtx.transferFromImageBitmap(event.data);
+                    worker.postMessage(null);
+                });
+            },
+        );
+        worker.postMessage({ baseUrl: document.baseURI });
+        return;
+    }
+
     const ctx = canvas.getContext("2d");
     if (ctx == null) {
         throw new Error("2d canvas not supported");
     }
 
-    const imageData = new ImageData(imageWidth, imageHeight);
-
     const rasterizer = new WasmRasterizer();
 
-    const lookFrom: Vec3 = [0.0, 0.0, 0.0];
-    const lookAt: Vec3 = [0.0, 0.0, -1.0];
-    const vup: Vec3 = [0.0, 1.0, 0.0];
-
-    await rasterizer.initializeWasmImport(wasmImportUrl);
-
-    rasterizer.initializeBuffers(imageWidth, imageHeight, imageChannels);
-
-    rasterizer.setCamera(vFov, lookFrom, lookAt, vup);
-
-    const initPosition = [0.0, 0.0, -3.0] as Vec3;
-    const initRotation = [0.0, 0.0, 0.0] as Vec3;
-    const initHeight = 1.0;
-
-    await rasterizer.pushEntity(
-        objUrl,
-        textureUrl,
-        initPosition,
-        initRotation,
-        initHeight,
-    );
-
-    const rotation = [0.0, 5.0, 0.0] as Vec3;
+    await setupScene(rasterizer, document.baseURI);
 
     const frame = (timestamp: number) => {
-        ctx.clearRect(0, 0, imageWidth, imageHeight);
-        rasterizer.rotateEntity(0, rotation);
+        updateScene(rasterizer);
         rasterizer.render();
-        rasterizer.writeToImageData(imageData);
-        ctx.putImageData(imageData, 0, 0);
+        ctx.putImageData(rasterizer.getImageData(), 0, 0);
         requestAnimationFrame(frame);
     };
     requestAnimationFrame(frame);
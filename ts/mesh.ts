@@ -0,0 +1,138 @@
+import * as utils from "./utils.js";
+import { Allocator } from "./utils.js";
+import { ObjStruct, Shading } from "./obj.js";
+
+// see mesh.h
+export const MESH_MAGIC = 0x4853454d;
+export const MESH_VERSION = 2;
+export const MESH_ALIGNMENT = 16;
+export const MESH_TEXTURED = 1 << 0;
+
+const MESH_HEADER_BYTE_SIZE = 8 * utils.UINT32_SIZE;
+
+interface MeshHeader {
+    size: number;
+    flags: number;
+
+    vertexCount: number;
+    faceCount: number;
+
+    vertices: number;
+    faces: number;
+}
+
+const alignUp = (n: number): number =>
+    Math.ceil(n / MESH_ALIGNMENT) * MESH_ALIGNMENT;
+
+// same as mesh_layout
+const meshLayout = (vertexCount: number, faceCount: number): MeshHeader => {
+    const vertices = alignUp(MESH_HEADER_BYTE_SIZE);
+    const faces = alignUp(vertices + vertexCount * ObjStruct.VERTEX_BYTE_SIZE);
+    const size = alignUp(faces + faceCount * ObjStruct.FACE_ELEMENT_BYTE_SIZE);
+
+    return {
+        size,
+        flags: 0,
+        vertexCount,
+        faceCount,
+        vertices,
+        faces,
+    };
+};
+
+// mesh files start with the magic
+export const isMesh = (bytes: ArrayBuffer): boolean =>
+    bytes.byteLength >= utils.UINT32_SIZE &&
+    new DataView(bytes).getUint32(0, true) === MESH_MAGIC;
+
+const readHeader = (bytes: ArrayBuffer): MeshHeader => {
+    if (bytes.byteLength < MESH_HEADER_BYTE_SIZE) {
+        throw new Error("mesh file too short");
+    }
+
+    const view = new DataView(bytes);
+    const u32 = (i: number) => view.getUint32(i * utils.UINT32_SIZE, true);
+
+    const header = meshLayout(u32(4), u32(5));
+    if (
+        u32(0) !== MESH_MAGIC ||
+        u32(1) !== MESH_VERSION ||
+        u32(2) !== header.size ||
+        (u32(3) & ~MESH_TEXTURED) !== 0 ||
+        u32(6) !== header.vertices ||
+        u32(7) !== header.faces ||
+        header.size > bytes.byteLength
+    ) {
+        throw new Error("invalid mesh file");
+    }
+    header.flags = u32(3);
+    return header;
+};
+
+const cacheByteSize = (header: MeshHeader): number =>
+    header.vertexCount * ObjStruct.SCREEN_VERTEX_BYTE_SIZE +
+    header.faceCount * ObjStruct.FACE_SETUP_BYTE_SIZE +
+    header.vertexCount * utils.FLOAT32_SIZE +
+    header.faceCount * utils.FLOAT32_SIZE;
+
+// bytes parseMesh allocates. reserve them before parsing so the memory
+// does not grow under the views it writes through
+export const meshAllocationSize = (bytes: ArrayBuffer): number => {
+    const header = readHeader(bytes);
+    return ObjStruct.BYTE_SIZE + header.size + cacheByteSize(header);
+};
+
+export const loadMesh = async (meshURL: string): Promise<ArrayBuffer> => {
+    return fetch(meshURL).then((response) => response.arrayBuffer());
+};
+
+// the file is copied into the object arena as is, header included, and the
+// object points at its arrays in place. the screen space cache follows
+export const parseMesh = (
+    bytes: ArrayBuffer,
+    malloc: Allocator,
+    memory: ArrayBuffer,
+    view: DataView,
+): number => {
+    const header = readHeader(bytes);
+
+    const obj = new ObjStruct(view, malloc);
+
+    obj.vertexCount.write(header.vertexCount);
+    obj.faceCount.write(header.faceCount);
+
+    const arenaPtr = malloc(header.size + cacheByteSize(header));
+    new Uint8Array(memory, arenaPtr, header.size).set(
+        new Uint8Array(bytes, 0, header.size),
+    );
+
+    obj.arenaPtr.write(arenaPtr);
+
+    obj.verticesPtr.write(arenaPtr + header.vertices);
+    obj.faceElementsPtr.write(arenaPtr + header.faces);
+
+    const screenVerticesPtr = arenaPtr + header.size;
+    const faceSetupsPtr =
+        screenVerticesPtr +
+        header.vertexCount * ObjStruct.SCREEN_VERTEX_BYTE_SIZE;
+    const vertexIntensitiesPtr =
+        faceSetupsPtr + header.faceCount * ObjStruct.FACE_SETUP_BYTE_SIZE;
+    const faceIntensitiesPtr =
+        vertexIntensitiesPtr + header.vertexCount * utils.FLOAT32_SIZE;
+
+    obj.dirty.write(1);
+    obj.cameraEpoch.write(0);
+
+    obj.screenVerticesPtr.write(screenVerticesPtr);
+    obj.faceSetupsPtr.write(faceSetupsPtr);
+
+    obj.shading.write(Shading.Pixel);
+    obj.textured.write(header.flags & MESH_TEXTURED ? 1 : 0);
+    obj.vertexIntensitiesPtr.write(vertexIntensitiesPtr);
+    obj.faceIntensitiesPtr.write(faceIntensitiesPtr);
+
+    obj.qverticesPtr.write(0);
+    obj.qfacesPtr.write(0);
+
+    return obj.ptr;
+};
@@ -0,0 +1,28 @@
+import { Allocator, UINT32_SIZE } from "./utils.js";
+
+// see meshz_parse.h
+export const MESHZ_MAGIC = 0x5a48534d;
+
+// meshz files start with the magic
+export const isMeshz = (bytes: ArrayBuffer): boolean =>
+    bytes.byteLength >= UINT32_SIZE &&
+    new DataView(bytes).getUint32(0, true) === MESHZ_MAGIC;
+
+// like parseSTL, meshz_parse decodes the copied bytes into the object
+// arrays and moves the object down over them. memory must have room for
+// the bytes, meshz_parse grows it for the object
+export const parseMeshz = (
+    meshzFile: Uint8Array,
+    malloc: Allocator,
+    memory: ArrayBuffer,
+    meshzParse: (bytesPtr: number, size: number) => number,
+): number => {
+    const bytesPtr = malloc(meshzFile.length);
+    new Uint8Array(memory, bytesPtr, meshzFile.length).set(meshzFile);
+
+    const objPtr = meshzParse(bytesPtr, meshzFile.length);
+    if (objPtr === 0) {
+        throw new Error("invalid or too large meshz file");
+    }
+    return objPtr;
+};
@@ -1,170 +1,108 @@
 import * as utils from "./utils.js";
 import { Vec3Struct, Float32, Uint32, Allocator } from "./utils.js";
 
+// see camera.h, cheapest last
+export enum Shading {
+    // interpolate normals, light every pixel
+    Pixel = 0,
+    // light every vertex, interpolate the intensity
+    Gouraud = 1,
+    // light every face once
+    Flat = 2,
+}
+
 export class ObjStruct {
-    static readonly VERTEX_BYTE_SIZE = 3 * utils.FLOAT32_SIZE;
-    static readonly VERTEX_TEXTURE_BYTE_SIZE = 2 * utils.FLOAT32_SIZE;
-    static readonly VERTEX_NORMAL_BYTE_SIZE = 3 * utils.FLOAT32_SIZE;
-    static readonly FACE_ELEMENT_BYTE_SIZE = 9 * utils.UINT32_SIZE;
+    // position, normal and texture coordinate
+    static readonly VERTEX_BYTE_SIZE = 8 * utils.FLOAT32_SIZE;
+    static readonly FACE_ELEMENT_BYTE_SIZE = 3 * utils.UINT32_SIZE;
+    static readonly SCREEN_VERTEX_BYTE_SIZE =
+        2 * utils.UINT32_SIZE + 2 * utils.FLOAT32_SIZE;
+    static readonly FACE_SETUP_BYTE_SIZE = 4 * utils.UINT32_SIZE;
+    // how quantized vertices map back, two mat3, a vec3 and two vec2
+    static readonly DEQUANTIZE_BYTE_SIZE = 25 * utils.FLOAT32_SIZE;
+    // the struct itself, 47 words counting each vec3 as 3 and each mat3
+    // as 9
+    static readonly BYTE_SIZE = 47 * utils.UINT32_SIZE;
 
     readonly vertexCount: Uint32;
-    readonly vertexTextureCount: Uint32;
-    readonly vertexNormalCount: Uint32;
     readonly faceCount: Uint32;
 
     readonly position: Vec3Struct;
     readonly rotation: Vec3Struct;
     readonly height: Float32;
 
+    readonly shading: Uint32;
+    readonly textured: Uint32;
+
     readonly arenaPtr: Uint32;
 
     readonly verticesPtr: Uint32;
-    readonly vertexTexturesPtr: Uint32;
-    readonly vertexNormalsPtr: Uint32;
     readonly faceElementsPtr: Uint32;
 
+    readonly dirty: Uint32;
+    readonly cameraEpoch: Uint32;
+
+    readonly screenVerticesPtr: Uint32;
+    readonly faceSetupsPtr: Uint32;
+
+    readonly vertexIntensitiesPtr: Uint32;
+    readonly faceIntensitiesPtr: Uint32;
+
+    // 0 unless the object is quantized, see obj_quantize in obj_parse.h
+    readonly qverticesPtr: Uint32;
+    readonly qfacesPtr: Uint32;
+    readonly dequantizePtr: number;
+
     readonly ptr: number;
 
     constructor(view: DataView, malloc: Allocator) {
         this.vertexCount = new Uint32(view, malloc);
-        this.vertexTextureCount = new Uint32(view, malloc);
-        this.vertexNormalCount = new Uint32(view, malloc);
         this.faceCount = new Uint32(view, malloc);
 
         this.position = new Vec3Struct(view, malloc);
         this.rotation = new Vec3Struct(view, malloc);
         this.height = new Float32(view, malloc);
 
+        this.shading = new Uint32(view, malloc);
+        this.textured = new Uint32(view, malloc);
+
         this.arenaPtr = new Uint32(view, malloc);
 
         this.verticesPtr = new Uint32(view, malloc);
-        this.vertexTexturesPtr = new Uint32(view, malloc);
-        this.vertexNormalsPtr = new Uint32(view, malloc);
         this.faceElementsPtr = new Uint32(view, malloc);
 
+        this.dirty = new Uint32(view, malloc);
+        this.cameraEpoch = new Uint32(view, malloc);
+
+        this.screenVerticesPtr = new Uint32(view, malloc);
+        this.faceSetupsPtr = new Uint32(view, malloc);
+
+        this.vertexIntensitiesPtr = new Uint32(view, malloc);
+        this.faceIntensitiesPtr = new Uint32(view, malloc);
+
+        this.qverticesPtr = new Uint32(view, malloc);
+        this.qfacesPtr = new Uint32(view, malloc);
+        this.dequantizePtr = malloc(ObjStruct.DEQUANTIZE_BYTE_SIZE);
+
         this.ptr = this.vertexCount.ptr;
     }
 }
 
-export const loadOBJ = async (
-    objURL: string,
-    malloc: (n: number) => number,
-    memory: ArrayBuffer,
-    view: DataView,
-): Promise<number> => {
-    return fetch(objURL)
-        .then((response) => response.text())
-        .then((body) => parseOBJ(body, malloc, memory, view));
-};
-
-const parseOBJ = (
-    objFile: string,
-    malloc: (n: number) => number,
+// copies the text to the top of the heap and lets obj_parse build the
+// object over it, so nothing but the bytes is ever held on the js side.
+// memory must have room for the text, obj_parse grows it for the object
+export const parseOBJ = (
+    objFile: Uint8Array,
+    malloc: Allocator,
     memory: ArrayBuffer,
-    view: DataView,
+    objParse: (textPtr: number, size: number) => number,
 ): number => {
-    let obj = new ObjStruct(view, malloc);
-
-    let vertexCount = 0,
-        vertexTextureCount = 0,
-        vertexNormalCount = 0,
-        faceCount = 0;
-
-    let lines = objFile.split("\n");
-
-    for (const line of lines) {
-        if (line.startsWith("v ")) {
-            vertexCount++;
-        } else if (line.startsWith("vt ")) {
-            vertexTextureCount++;
-        } else if (line.startsWith("vn ")) {
-            vertexNormalCount++;
-        } else if (line.startsWith("f ")) {
-            faceCount++;
-        }
-    }
+    const textPtr = malloc(objFile.length);
+    new Uint8Array(memory, textPtr, objFile.length).set(objFile);
 
-    obj.vertexCount.write(vertexCount);
-    obj.vertexTextureCount.write(vertexTextureCount);
-    obj.vertexNormalCount.write(vertexNormalCount);
-    obj.faceCount.write(faceCount);
-
-    const verticesArrayByteSize = vertexCount * ObjStruct.VERTEX_BYTE_SIZE;
-
-    const vertexTexturesArrayByteSize =
-        vertexTextureCount * ObjStruct.VERTEX_TEXTURE_BYTE_SIZE;
-
-    const vertexNormalArrayByteSize =
-        vertexNormalCount * ObjStruct.VERTEX_NORMAL_BYTE_SIZE;
-
-    const facesArrayByteSize = faceCount * ObjStruct.FACE_ELEMENT_BYTE_SIZE;
-
-    const arenaPtr = malloc(
-        verticesArrayByteSize +
-            vertexTexturesArrayByteSize +
-            vertexNormalArrayByteSize +
-            facesArrayByteSize,
-    );
-
-    obj.arenaPtr.write(arenaPtr);
-
-    const verticesPtr = arenaPtr;
-    const vertexTexturesPtr = verticesPtr + verticesArrayByteSize;
-    const vertexNormalsPtr = vertexTexturesPtr + vertexTexturesArrayByteSize;
-    const faceElementsPtr = vertexNormalsPtr + vertexNormalArrayByteSize;
-
-    obj.verticesPtr.write(verticesPtr);
-    obj.vertexTexturesPtr.write(vertexTexturesPtr);
-    obj.vertexNormalsPtr.write(vertexNormalsPtr);
-    obj.faceElementsPtr.write(faceElementsPtr);
-
-    const vertices = new Float32Array(memory, verticesPtr, 3 * vertexCount);
-    const vertexTextures = new Float32Array(
-        memory,
-        vertexTexturesPtr,
-        2 * vertexTextureCount,
-    );
-    const vertexNormals = new Float32Array(
-        memory,
-        vertexNormalsPtr,
-        3 * vertexNormalCount,
-    );
-    const faces = new Uint32Array(memory, faceElementsPtr, 9 * faceCount);
-
-    let verticesIdx = 0,
-        vertexTexturesIdx = 0,
-        vertexNormalsIdx = 0,
-        facesIdx = 0;
-
-    for (const line of lines) {
-        if (line.startsWith("v ")) {
-            const [_, v1, v2, v3] = line.split(/\s+/);
-            vertices[verticesIdx + 0] = parseFloat(v1);
-            vertices[verticesIdx + 1] = parseFloat(v2);
-            vertices[verticesIdx + 2] = parseFloat(v3);
-            verticesIdx += 3;
-        } else if (line.startsWith("vt ")) {
-            const [_, vt1, vt2, __] = line.split(/\s+/);
-            vertexTextures[vertexTexturesIdx + 0] = parseFloat(vt1);
-            vertexTextures[vertexTexturesIdx + 1] = parseFloat(vt2);
-            vertexTexturesIdx += 2;
-        } else if (line.startsWith("vn ")) {
-            const [_, vn1, vn2, vn3] = line.split(/\s+/);
-            vertexNormals[vertexNormalsIdx + 0] = parseFloat(vn1);
-            vertexNormals[vertexNormalsIdx + 1] = parseFloat(vn2);
-            vertexNormals[vertexNormalsIdx + 2] = parseFloat(vn3);
-            vertexNormalsIdx += 3;
-        } else if (line.startsWith("f ")) {
-            const fs = line.split(" ").slice(1);
-            for (let i = 0; i < 3; i++) {
-                const [f1, f2, f3] = fs[i].split("/");
-                faces[facesIdx + i + 0] = parseInt(f1) - 1;
-                faces[facesIdx + i + 3] = parseInt(f2) - 1;
-                faces[facesIdx + i + 6] = parseInt(f3) - 1;
-            }
-            facesIdx += 9;
-        }
+    const objPtr = objParse(textPtr, objFile.length);
+    if (objPtr === 0) {
+        throw new Error("invalid or too large obj file");
     }
-
-    return obj.ptr;
+    return objPtr;
 };
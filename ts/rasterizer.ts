@@ -1,29 +1,74 @@
-import * as utils from "./utils.js";
-import { Allocator, Vec3, Vec3Struct } from "./utils.js";
-
-import { loadOBJ } from "./obj.js";
-import { loadTexture } from "./texture.js";
+import { Allocator, UINT32_SIZE, Vec3, Vec3Struct } from "./utils.js";
+
+import {
+    allocateFramebuffer,
+    DepthFormat,
+    framebufferSize,
+    FramebufferStruct,
+} from "./framebuffer.js";
+import { isGLB, parseGLB } from "./glb.js";
+import { isMesh, loadMesh, meshAllocationSize, parseMesh } from "./mesh.js";
+import { isMeshz, parseMeshz } from "./meshz.js";
+import { parseOBJ, Shading } from "./obj.js";
+import { parseSTL } from "./stl.js";
+import {
+    AddressMode,
+    Filter,
+    loadTexture,
+    TEXTURE_BLOCK_SHIFT,
+    textureAllocationSize,
+    TextureSource,
+    writeTexture,
+} from "./texture.js";
 
 type ObjModifier = (ObjPtr: number, x: number, y: number, z: number) => void;
 
+type StreamParse = (streamPtr: number, n: number, last: number) => number;
+
 export class WasmRasterizer {
     private wasmExports!: WebAssembly.Exports;
+    private wasmMemory!: WebAssembly.Memory;
+
+    // views into wasmMemory.buffer, which is detached and replaced whenever
+    // the memory grows, see refreshMemoryViews
     private memory!: ArrayBuffer;
     private view!: DataView;
 
     private cameraPtr!: number;
+    private lightCameraPtr!: number;
     private lookFromPtr!: number;
     private lookAtPtr!: number;
     private vupPtr!: number;
 
     private malloc!: Allocator;
 
+    private bumpReserve!: (n: number) => void;
+
+    private objParse!: (textPtr: number, size: number) => number;
+
+    private objStreamBegin!: (size: number) => number;
+
+    private objStreamBuffer!: (streamPtr: number, n: number) => number;
+
+    private objStreamParse!: StreamParse;
+
+    private stlParse!: (bytesPtr: number, size: number) => number;
+
+    private stlStreamParse!: StreamParse;
+
+    private glbParse!: (bytesPtr: number, size: number) => number;
+    private meshzParse!: (bytesPtr: number, size: number) => number;
+
+    private quantizeObj!: (objPtr: number) => number;
+
     private cameraInitialize!: (
         camPtr: number,
         imageWidth: number,
         imageHeight: number,
         imageChannels: number,
         vfov: number,
+        depthNear: number,
+        depthFar: number,
     ) => void;
 
     private objPSR!: (objPtr: number) => void;
@@ -34,25 +79,64 @@ export class WasmRasterizer {
 
     private objSetHeight!: (objPtr: number, height: number) => void;
 
+    private objSetShading!: (objPtr: number, shading: Shading) => void;
+
     private objShiftBy!: ObjModifier;
 
     private objRotateBy!: ObjModifier;
 
     private rasterizeObj!: (
-        imageBufferPtr: number,
+        framebufferPtr: number,
         cameraPtr: number,
         objPtr: number,
         texturePtr: number,
-        zBufferPtr: number,
     ) => void;
 
-    private testFunc!: (objPtr: number) => number;
+    private rasterizeObjDepth!: (
+        framebufferPtr: number,
+        cameraPtr: number,
+        objPtr: number,
+    ) => void;
+
+    private framebufferClear!: (framebufferPtr: number) => void;
 
-    private imageBufferPtr!: number;
-    private imageBuffer!: Uint8ClampedArray;
+    private framebufferResolve!: (framebufferPtr: number) => void;
+
+    private framebufferResolveDepth!: (framebufferPtr: number) => void;
+
+    private cameraOccluded!: (
+        framebufferPtr: number,
+        cameraPtr: number,
+        x0: number,
+        y0: number,
+        x1: number,
+        y1: number,
+        x: number,
+        y: number,
+        z: number,
+    ) => number;
+
+    private textureLevelsSize!: (
+        texturePtr: number,
+        blockShift: number,
+    ) => number;
+
+    private textureBuildLevels!: (
+        texturePtr: number,
+        blockShift: number,
+        storagePtr: number,
+    ) => void;
+
+    private testFunc!: (objPtr: number) => number;
 
-    private zBufferPtr!: number;
-    private zBuffer!: Float32Array;
+    // render() draws into frames[backIdx] while frames[frontIdx], the last
+    // completed frame, stays untouched for presentation
+    private frames!: Frame[];
+    private frontIdx!: number;
+    private backIdx!: number;
+    // depth alone from the light's camera, allocated by the first
+    // setLightCamera
+    private lightFrame?: DepthFrame;
 
     private lookFrom!: Float32Array;
     private lookAt!: Float32Array;
@@ -61,28 +145,114 @@ export class WasmRasterizer {
     private imageWidth!: number;
     private imageHeight!: number;
     private imageChannels!: number;
+    private samples!: number;
+    private depthFormat!: DepthFormat;
 
     private entities!: Entity[];
 
+    // false while nothing rendered has changed since the last render()
+    private sceneDirty!: boolean;
+
+    // performance.now() after the first render() that drew any faces
+    firstPixelTime?: number;
+
+    // layout of textures pushed from now on, 0 keeps them row major
+    textureBlockShift: number = TEXTURE_BLOCK_SHIFT;
+
+    // how those textures sample uvs outside [0, 1]
+    textureAddressMode: AddressMode = AddressMode.Wrap;
+
+    // and how they filter, bilinear costs about 1.2x nearest per fragment
+    textureFilter: Filter = Filter.Nearest;
+
+    // whether models pushed from now on are quantized to 16 bits a
+    // component, see obj_quantize in c/obj_parse.h. less than half the
+    // memory and bandwidth for a little precision. streamed files are
+    // quantized once the whole file is in
+    quantizeModels: boolean = false;
+
+    // whether render() draws every entity's depth before shading any, see
+    // rasterize_obj_depth in c/camera.h. each pixel is then shaded once,
+    // which pays off when models overlap
+    depthPrepass: boolean = false;
+
     constructor() {}
 
     async initializeWasmImport(wasmFilePath: string): Promise<void> {
         const { instance } = await WebAssembly.instantiateStreaming(
             fetch(wasmFilePath),
         );
+        this.initializeWasmInstance(instance);
+    }
+
+    // for hosts without fetch on local files, e.g. node
+    async initializeWasmBytes(wasmBytes: BufferSource): Promise<void> {
+        const { instance } = await WebAssembly.instantiate(wasmBytes);
+        this.initializeWasmInstance(instance);
+    }
 
+    private initializeWasmInstance(instance: WebAssembly.Instance): void {
         this.wasmExports = instance.exports;
 
-        let wasmMemory = this.wasmExports.memory as WebAssembly.Memory;
-        this.memory = wasmMemory.buffer;
-        this.view = new DataView(this.memory);
+        this.wasmMemory = this.wasmExports.memory as WebAssembly.Memory;
 
         this.cameraPtr = this.wasmExports.cam.valueOf() as number;
+        this.lightCameraPtr = this.wasmExports.light_cam.valueOf() as number;
         this.lookFromPtr = this.wasmExports.look_from.valueOf() as number;
         this.lookAtPtr = this.wasmExports.look_at.valueOf() as number;
         this.vupPtr = this.wasmExports.vup.valueOf() as number;
 
-        this.malloc = this.wasmExports.bump_malloc as Allocator;
+        // both give 0 when the memory cannot grow
+        const bumpMalloc = this.wasmExports.bump_malloc as Allocator;
+        this.malloc = (n: number): number => {
+            const ptr = bumpMalloc(n);
+            if (ptr === 0) {
+                throw new Error(`out of memory allocating ${n} bytes`);
+            }
+            return ptr;
+        };
+        const bumpReserve = this.wasmExports.bump_reserve as (
+            n: number,
+        ) => number;
+        this.bumpReserve = (n: number): void => {
+            if (!bumpReserve(n)) {
+                throw new Error(`out of memory reserving ${n} bytes`);
+            }
+        };
+
+        this.objParse = this.wasmExports.obj_parse as (
+            textPtr: number,
+            size: number,
+        ) => number;
+
+        this.objStreamBegin = this.wasmExports.obj_stream_begin as (
+            size: number,
+        ) => number;
+        this.objStreamBuffer = this.wasmExports.obj_stream_buffer as (
+            streamPtr: number,
+            n: number,
+        ) => number;
+        this.objStreamParse = this.wasmExports.obj_stream_parse as StreamParse;
+
+        this.stlParse = this.wasmExports.stl_parse as (
+            bytesPtr: number,
+            size: number,
+        ) => number;
+        this.stlStreamParse = this.wasmExports.stl_stream_parse as StreamParse;
+
+        this.glbParse = this.wasmExports.glb_parse as (
+            bytesPtr: number,
+            size: number,
+        ) => number;
+
+        this.meshzParse = this.wasmExports.meshz_parse as (
+            bytesPtr: number,
+            size: number,
+        ) => number;
+
+        this.quantizeObj = this.wasmExports.quantize_obj as (
+            objPtr: number,
+        ) => number;
 
         this.cameraInitialize = this.wasmExports.camera_initialize as (
             camPtr: number,
@@ -90,6 +260,8 @@ export class WasmRasterizer {
             imageHeight: number,
             imageChannels: number,
             vfov: number,
+            depthNear: number,
+            depthFar: number,
         ) => void;
 
         this.objPSR = this.wasmExports.obj_psr as (objPtr: number) => void;
@@ -100,76 +272,261 @@ export class WasmRasterizer {
             objPtr: number,
             height: number,
         ) => void;
+        this.objSetShading = this.wasmExports.obj_set_shading as (
+            objPtr: number,
+            shading: Shading,
+        ) => void;
 
-        this.objShiftBy = this.wasmExports.obj_shify_by as ObjModifier;
+        this.objShiftBy = this.wasmExports.obj_shift_by as ObjModifier;
         this.objRotateBy = this.wasmExports.obj_rotate_by as ObjModifier;
 
         this.rasterizeObj = this.wasmExports.rasterize_obj as (
-            imageBufferPtr: number,
+            framebufferPtr: number,
             cameraPtr: number,
             objPtr: number,
             texturePtr: number,
-            zBufferPtr: number,
+        ) => void;
+
+        this.rasterizeObjDepth = this.wasmExports.rasterize_obj_depth as (
+            framebufferPtr: number,
+            cameraPtr: number,
+            objPtr: number,
+        ) => void;
+
+        this.framebufferClear = this.wasmExports.framebuffer_clear as (
+            framebufferPtr: number,
+        ) => void;
+        this.framebufferResolve = this.wasmExports.framebuffer_resolve as (
+            framebufferPtr: number,
+        ) => void;
+        this.framebufferResolveDepth = this.wasmExports
+            .framebuffer_resolve_depth as (framebufferPtr: number) => void;
+        this.cameraOccluded = this.wasmExports.camera_occluded as (
+            framebufferPtr: number,
+            cameraPtr: number,
+            x0: number,
+            y0: number,
+            x1: number,
+            y1: number,
+            x: number,
+            y: number,
+            z: number,
+        ) => number;
+
+        this.textureLevelsSize = this.wasmExports.texture_levels_size as (
+            texturePtr: number,
+            blockShift: number,
+        ) => number;
+        this.textureBuildLevels = this.wasmExports.texture_build_levels as (
+            texturePtr: number,
+            blockShift: number,
+            storagePtr: number,
         ) => void;
 
         this.testFunc = this.wasmExports.test_func as (
             objPtr: number,
         ) => number;
 
+        this.refreshMemoryViews();
+    }
+
+    private refreshMemoryViews(): void {
+        if (this.memory === this.wasmMemory.buffer) {
+            return;
+        }
+
+        this.memory = this.wasmMemory.buffer;
+        this.view = new DataView(this.memory);
+
         this.lookFrom = new Float32Array(this.memory, this.lookFromPtr, 3);
 
         this.lookAt = new Float32Array(this.memory, this.lookAtPtr, 3);
 
         this.vup = new Float32Array(this.memory, this.vupPtr, 3);
+
+        if (this.frames !== undefined) {
+            for (const frame of this.frames) {
+                this.createImageViews(frame);
+            }
+        }
+    }
+
+    private createImageViews(frame: Frame): void {
+        frame.imageBuffer = new Uint8ClampedArray(
+            this.memory,
+            frame.imagePtr,
+            this.imageWidth * this.imageHeight * this.imageChannels,
+        );
+        // built on first use by getImageData, ImageData only exists in
+        // browsers
+        frame.imageData = undefined;
     }
 
     initializeBuffers(
         imageWidth: number,
         imageHeight: number,
         imageChannels: number,
+        frameCount = 2,
+        samples = 1,
+        depthFormat = DepthFormat.Float32,
     ): void {
         this.imageWidth = imageWidth;
         this.imageHeight = imageHeight;
         this.imageChannels = imageChannels;
-
-        this.imageBufferPtr = this.malloc(
-            imageWidth * imageHeight * imageChannels * utils.UINT8_SIZE,
+        this.samples = samples;
+        this.depthFormat = depthFormat;
+
+        // grow memory once up front, the framebuffer structs write through
+        // this.view while allocating
+        this.bumpReserve(
+            frameCount *
+                framebufferSize(
+                    imageWidth,
+                    imageHeight,
+                    imageChannels,
+                    samples,
+                    depthFormat,
+                ),
         );
+        this.refreshMemoryViews();
+
+        const framebuffers: FramebufferStruct[] = [];
+        for (let i = 0; i < frameCount; i++) {
+            framebuffers.push(
+                allocateFramebuffer(
+                    imageWidth,
+                    imageHeight,
+                    imageChannels,
+                    this.malloc,
+                    this.view,
+                    samples,
+                    depthFormat,
+                ),
+            );
+        }
 
-        this.imageBuffer = new Uint8ClampedArray(
-            this.memory,
-            this.imageBufferPtr,
-            imageWidth * imageHeight * imageChannels,
-        );
-        this.imageBuffer.fill(0);
+        this.refreshMemoryViews();
+
+        this.frames = framebuffers.map((framebuffer) => {
+            const frame: Frame = {
+                ptr: framebuffer.ptr,
+                imagePtr: framebuffer.imagePtr.read(),
+                zBufferPtr: framebuffer.zBufferPtr.read(),
+                imageBuffer: new Uint8ClampedArray(0),
+            };
+            this.createImageViews(frame);
+            frame.imageBuffer.fill(0);
+            return frame;
+        });
+        this.frontIdx = 0;
+        this.backIdx = 1 % frameCount;
 
-        this.zBufferPtr = this.malloc(
-            imageWidth * imageHeight * utils.FLOAT32_SIZE,
-        );
-        this.zBuffer = new Float32Array(
-            this.memory,
-            this.zBufferPtr,
-            imageWidth * imageHeight,
-        );
-        this.zBuffer.fill(-Infinity);
+        this.lightFrame = undefined;
 
         this.entities = [];
+        this.sceneDirty = true;
+    }
+
+    // depthNear and depthFar are distances from lookFrom along the view, the
+    // integer depth formats spread them over their range and clamp what is
+    // outside it
+    setCamera(
+        vFov: number,
+        lookFrom: Vec3,
+        lookAt: Vec3,
+        vup: Vec3,
+        depthNear = 0,
+        depthFar = 10,
+    ): void {
+        this.initializeCamera(
+            this.cameraPtr,
+            vFov,
+            lookFrom,
+            lookAt,
+            vup,
+            depthNear,
+            depthFar,
+        );
+        this.sceneDirty = true;
     }
 
-    setCamera(vFov: number, lookFrom: Vec3, lookAt: Vec3, vup: Vec3): void {
+    // the camera renderDepth draws from, e.g. a light's for a shadow map.
+    // its depth has the image's size and depth format, one sample a pixel
+    setLightCamera(
+        vFov: number,
+        lookFrom: Vec3,
+        lookAt: Vec3,
+        vup: Vec3,
+        depthNear = 0,
+        depthFar = 10,
+    ): void {
+        if (this.lightFrame === undefined) {
+            this.bumpReserve(
+                framebufferSize(
+                    this.imageWidth,
+                    this.imageHeight,
+                    this.imageChannels,
+                    1,
+                    this.depthFormat,
+                ),
+            );
+            this.refreshMemoryViews();
+
+            const framebuffer = allocateFramebuffer(
+                this.imageWidth,
+                this.imageHeight,
+                this.imageChannels,
+                this.malloc,
+                this.view,
+                1,
+                this.depthFormat,
+            );
+            this.lightFrame = {
+                ptr: framebuffer.ptr,
+                zBufferPtr: framebuffer.zBufferPtr.read(),
+            };
+        }
+        this.initializeCamera(
+            this.lightCameraPtr,
+            vFov,
+            lookFrom,
+            lookAt,
+            vup,
+            depthNear,
+            depthFar,
+        );
+    }
+
+    private initializeCamera(
+        cameraPtr: number,
+        vFov: number,
+        lookFrom: Vec3,
+        lookAt: Vec3,
+        vup: Vec3,
+        depthNear: number,
+        depthFar: number,
+    ): void {
+        this.refreshMemoryViews();
         this.lookFrom.set(lookFrom);
         this.lookAt.set(lookAt);
         this.vup.set(vup);
 
         this.cameraInitialize(
-            this.cameraPtr,
+            cameraPtr,
             this.imageWidth,
             this.imageHeight,
             this.imageChannels,
             vFov,
+            depthNear,
+            depthFar,
         );
     }
 
+    // objUrl is an obj, binary stl or glb file, or a mesh or meshz file
+    // baked from one, see c/bake.c. obj and stl files stream in: the entity
+    // is pushed once the texture is in and render() draws the faces that
+    // have arrived so far, the promise resolves when the whole file is
+    // parsed
     async pushEntity(
         objUrl: string,
         textureUrl: string,
@@ -177,65 +534,441 @@ export class WasmRasterizer {
         initialRotation: Vec3,
         initialHeight: number,
     ): Promise<void> {
-        const objPtrPromise = loadOBJ(
-            objUrl,
+        if (
+            objUrl.endsWith(".mesh") ||
+            objUrl.endsWith(".meshz") ||
+            objUrl.endsWith(".glb")
+        ) {
+            const [mesh, texturePtr] = await Promise.all([
+                loadMesh(objUrl),
+                this.fetchTexture(textureUrl),
+            ]);
+
+            // parsed after the texture so growing the memory for the mesh
+            // does not leave the texture loader with stale views
+            this.addEntity(
+                this.quantizeModel(this.parseModel(mesh)),
+                texturePtr,
+                initialPosition,
+                initialRotation,
+                initialHeight,
+            );
+            return;
+        }
+
+        const [response, texturePtr] = await Promise.all([
+            fetch(objUrl),
+            this.fetchTexture(textureUrl),
+        ]);
+        if (!response.ok || response.body === null) {
+            throw new Error(`error fetching ${objUrl}: ${response.status}`);
+        }
+
+        // the object ends up about as large as the file, grow the memory
+        // for it once instead of chunk by chunk. a compressed response
+        // gives the compressed size, which does not bound the file
+        const size = Number(response.headers.get("Content-Length"));
+        if (size > 0) {
+            this.bumpReserve(size);
+        }
+        const encoded = response.headers.get("Content-Encoding") !== null;
+
+        const isSTL = objUrl.endsWith(".stl");
+
+        const objPtr = this.objStreamBegin(size > 0 && !encoded ? size : 0);
+        if (objPtr === 0) {
+            throw new Error(`out of memory streaming ${objUrl}`);
+        }
+        this.addEntity(
+            objPtr,
+            texturePtr,
+            initialPosition,
+            initialRotation,
+            initialHeight,
+            false,
+        );
+
+        await this.streamModel(
+            response.body,
+            objPtr,
+            isSTL ? this.stlStreamParse : this.objStreamParse,
+            isSTL ? "stl" : "obj",
+        );
+
+        // the stream keeps its float arrays, the entity draws a quantized
+        // copy from now on
+        const quantizedPtr = this.quantizeModel(objPtr);
+        if (quantizedPtr !== objPtr) {
+            const entity = this.entities.find((e) => e.objPtr === objPtr);
+            if (entity !== undefined) {
+                entity.objPtr = quantizedPtr;
+            }
+        }
+    }
+
+    // same as pushEntity for an obj file, or mesh, meshz, glb or stl bytes,
+    // and texture already in memory
+    pushEntitySource(
+        objSource: string | ArrayBuffer,
+        texture: TextureSource,
+        initialPosition: Vec3,
+        initialRotation: Vec3,
+        initialHeight: number,
+    ): void {
+        const objPtr = this.quantizeModel(this.parseModel(objSource));
+
+        const texturePtr = this.storeTexture(texture);
+
+        this.addEntity(
+            objPtr,
+            texturePtr,
+            initialPosition,
+            initialRotation,
+            initialHeight,
+        );
+    }
+
+    private async fetchTexture(textureUrl: string): Promise<number> {
+        return this.storeTexture(await loadTexture(textureUrl));
+    }
+
+    // grows the memory for the texture and its mip chain up front, so the
+    // views writeTexture holds stay valid and addEntity does not grow it
+    private storeTexture(source: TextureSource): number {
+        this.bumpReserve(
+            textureAllocationSize(source, this.textureBlockShift),
+        );
+        this.refreshMemoryViews();
+        return writeTexture(
+            source,
             this.malloc,
             this.memory,
             this.view,
+            this.textureAddressMode,
+            this.textureFilter,
         );
-        const texturePtrPromise = loadTexture(
-            textureUrl,
+    }
+
+    // obj_stream_parse and stl_stream_parse place every piece themselves,
+    // like obj_psr
+    private async streamModel(
+        body: ReadableStream<Uint8Array>,
+        streamPtr: number,
+        streamParse: StreamParse,
+        format: string,
+    ): Promise<void> {
+        const reader = body.getReader();
+        for (;;) {
+            const { done, value } = await reader.read();
+            const chunk = value ?? new Uint8Array(0);
+
+            const textPtr = this.objStreamBuffer(streamPtr, chunk.length);
+            if (textPtr === 0) {
+                await reader.cancel();
+                throw new Error(`out of memory streaming ${format} file`);
+            }
+            this.refreshMemoryViews();
+            new Uint8Array(this.memory, textPtr, chunk.length).set(chunk);
+
+            if (!streamParse(streamPtr, chunk.length, done ? 1 : 0)) {
+                await reader.cancel();
+                throw new Error(`invalid or too large ${format} file`);
+            }
+            this.refreshMemoryViews();
+            this.sceneDirty = true;
+
+            if (done) {
+                return;
+            }
+        }
+    }
+
+    private parseModel(model: string | ArrayBuffer): number {
+        if (typeof model === "string") {
+            return this.parseOBJBytes(new TextEncoder().encode(model));
+        }
+        if (isMesh(model)) {
+            return this.parseMeshBytes(model);
+        }
+        if (isMeshz(model)) {
+            return this.parseMeshzBytes(new Uint8Array(model));
+        }
+        return isGLB(model)
+            ? this.parseGLBBytes(new Uint8Array(model))
+            : this.parseSTLBytes(new Uint8Array(model));
+    }
+
+    // quantized before anything else is allocated, so an object the parse
+    // functions built at the end of the heap is quantized in place
+    private quantizeModel(objPtr: number): number {
+        if (!this.quantizeModels) {
+            return objPtr;
+        }
+        const quantizedPtr = this.quantizeObj(objPtr);
+        if (quantizedPtr === 0) {
+            throw new Error("out of memory quantizing model");
+        }
+        this.refreshMemoryViews();
+        return quantizedPtr;
+    }
+
+    // these copy the file into memory once, after growing it for the copy
+    // so the views it goes through stay valid
+    private parseOBJBytes(bytes: Uint8Array): number {
+        this.bumpReserve(bytes.length);
+        this.refreshMemoryViews();
+        const objPtr = parseOBJ(bytes, this.malloc, this.memory, this.objParse);
+        this.refreshMemoryViews();
+        return objPtr;
+    }
+
+    private parseSTLBytes(bytes: Uint8Array): number {
+        this.bumpReserve(bytes.length);
+        this.refreshMemoryViews();
+        const objPtr = parseSTL(bytes, this.malloc, this.memory, this.stlParse);
+        this.refreshMemoryViews();
+        return objPtr;
+    }
+
+    private parseGLBBytes(bytes: Uint8Array): number {
+        this.bumpReserve(bytes.length + 3);
+        this.refreshMemoryViews();
+        const objPtr = parseGLB(bytes, this.malloc, this.memory, this.glbParse);
+        this.refreshMemoryViews();
+        return objPtr;
+    }
+
+    private parseMeshzBytes(bytes: Uint8Array): number {
+        this.bumpReserve(bytes.length);
+        this.refreshMemoryViews();
+        const objPtr = parseMeshz(
+            bytes,
             this.malloc,
             this.memory,
-            this.view,
+            this.meshzParse,
         );
+        this.refreshMemoryViews();
+        return objPtr;
+    }
 
-        const [objPtr, texturePtr] = await Promise.all([
-            objPtrPromise,
-            texturePtrPromise,
-        ]);
+    private parseMeshBytes(bytes: ArrayBuffer): number {
+        this.bumpReserve(meshAllocationSize(bytes));
+        this.refreshMemoryViews();
+        return parseMesh(bytes, this.malloc, this.memory, this.view);
+    }
+
+    private addEntity(
+        objPtr: number,
+        texturePtr: number,
+        initialPosition: Vec3,
+        initialRotation: Vec3,
+        initialHeight: number,
+        psr: boolean = true,
+    ): void {
+        this.textureBuildLevels(
+            texturePtr,
+            this.textureBlockShift,
+            this.malloc(
+                this.textureLevelsSize(texturePtr, this.textureBlockShift),
+            ),
+        );
 
         this.objSetPosition(objPtr, ...initialPosition);
         this.objSetRotation(objPtr, ...initialRotation);
         this.objSetHeight(objPtr, initialHeight);
 
-        this.objPSR(objPtr);
+        if (psr) {
+            this.objPSR(objPtr);
+        }
 
         this.entities.push({
             objPtr: objPtr,
             texturePtr: texturePtr,
         });
+        this.sceneDirty = true;
     }
 
     shiftEntity(idx: number, shift: Vec3): void {
         const entity = this.entities[idx];
         this.objShiftBy(entity.objPtr, ...shift);
+        this.sceneDirty = true;
     }
 
     rotateEntity(idx: number, rotation: Vec3): void {
         const entity = this.entities[idx];
         this.objRotateBy(entity.objPtr, ...rotation);
+        this.sceneDirty = true;
+    }
+
+    setEntityShading(idx: number, shading: Shading): void {
+        const entity = this.entities[idx];
+        this.objSetShading(entity.objPtr, shading);
+        this.sceneDirty = true;
     }
 
     render(): void {
-        this.imageBuffer.fill(0);
-        this.zBuffer.fill(-Infinity);
+        if (!this.sceneDirty) {
+            return;
+        }
+        const framebufferPtr = this.frames[this.backIdx].ptr;
+
+        this.framebufferClear(framebufferPtr);
+        if (this.depthPrepass) {
+            for (const entity of this.entities) {
+                this.rasterizeObjDepth(
+                    framebufferPtr,
+                    this.cameraPtr,
+                    entity.objPtr,
+                );
+            }
+        }
         for (const entity of this.entities) {
             this.rasterizeObj(
-                this.imageBufferPtr,
+                framebufferPtr,
                 this.cameraPtr,
                 entity.objPtr,
                 entity.texturePtr,
-                this.zBufferPtr,
             );
         }
+        this.framebufferResolve(framebufferPtr);
+
+        if (this.firstPixelTime === undefined && this.facesDrawn()) {
+            this.firstPixelTime = performance.now();
+        }
+
+        this.frontIdx = this.backIdx;
+        this.backIdx = (this.backIdx + 1) % this.frames.length;
+        this.sceneDirty = false;
+    }
+
+    // every entity's depth from the light camera into its own framebuffer,
+    // read back with getLightDepthBuffer or tested with lightOccluded. the
+    // rendered frame is left as it is
+    renderDepth(): void {
+        const lightFrame = this.lightFrame;
+        if (lightFrame === undefined) {
+            throw new Error("renderDepth needs a setLightCamera first");
+        }
+
+        this.framebufferClear(lightFrame.ptr);
+        for (const entity of this.entities) {
+            this.rasterizeObjDepth(
+                lightFrame.ptr,
+                this.lightCameraPtr,
+                entity.objPtr,
+            );
+        }
+        this.framebufferResolveDepth(lightFrame.ptr);
     }
 
-    writeToImageData(imageData: ImageData) {
-        imageData.data.set(this.imageBuffer);
+    // whether the light's depth hides everything in the pixel box from
+    // bboxMin to bboxMax (exclusive) at point or farther from the light,
+    // see framebuffer_occluded. as of the last renderDepth
+    lightOccluded(
+        bboxMin: [number, number],
+        bboxMax: [number, number],
+        point: Vec3,
+    ): boolean {
+        const lightFrame = this.lightFrame;
+        if (lightFrame === undefined) {
+            throw new Error("lightOccluded needs a setLightCamera first");
+        }
+        return (
+            this.cameraOccluded(
+                lightFrame.ptr,
+                this.lightCameraPtr,
+                ...bboxMin,
+                ...bboxMax,
+                ...point,
+            ) !== 0
+        );
+    }
+
+    // the depth of the last completed frame, aliasing wasm memory: minus the
+    // distance along the view for DepthFormat.Float32, the low 24 bits for
+    // Unorm24. larger is nearer in every format, the samples of a pixel are
+    // next to each other. Valid until memory grows
+    getDepthBuffer(): Float32Array | Uint16Array | Uint32Array {
+        return this.depthView(
+            this.frames[this.frontIdx].zBufferPtr,
+            this.samples,
+        );
+    }
+
+    // the depth of the last renderDepth, one sample a pixel, as
+    // getDepthBuffer
+    getLightDepthBuffer(): Float32Array | Uint16Array | Uint32Array {
+        if (this.lightFrame === undefined) {
+            throw new Error("no light depth without a setLightCamera");
+        }
+        return this.depthView(this.lightFrame.zBufferPtr, 1);
+    }
+
+    private depthView(
+        ptr: number,
+        samples: number,
+    ): Float32Array | Uint16Array | Uint32Array {
+        this.refreshMemoryViews();
+        const length = this.imageWidth * this.imageHeight * samples;
+        switch (this.depthFormat) {
+            case DepthFormat.Unorm16:
+                return new Uint16Array(this.memory, ptr, length);
+            case DepthFormat.Unorm24:
+                return new Uint32Array(this.memory, ptr, length);
+            default:
+                return new Float32Array(this.memory, ptr, length);
+        }
+    }
+
+    get entityCount(): number {
+        return this.entities.length;
+    }
+
+    // face_count is the second word of an object, see obj.h
+    private facesDrawn(): boolean {
+        this.refreshMemoryViews();
+        return this.entities.some(
+            (entity) =>
+                this.view.getUint32(entity.objPtr + UINT32_SIZE, true) > 0,
+        );
+    }
+
+    // the last completed frame, aliasing wasm memory so presenting it with
+    // putImageData needs no extra copy. Stays valid while the next frame
+    // renders into the back buffer
+    getImageData(): ImageData {
+        this.refreshMemoryViews();
+        const frame = this.frames[this.frontIdx];
+        if (frame.imageData === undefined) {
+            frame.imageData = new ImageData(
+                frame.imageBuffer,
+                this.imageWidth,
+                this.imageHeight,
+            );
+        }
+        return frame.imageData;
+    }
+
+    // the last completed frame as raw pixels, for hosts without ImageData
+    getImageBuffer(): Uint8ClampedArray {
+        this.refreshMemoryViews();
+        return this.frames[this.frontIdx].imageBuffer;
     }
 }
 
+type Frame = {
+    ptr: number;
+    imagePtr: number;
+    zBufferPtr: number;
+    imageBuffer: Uint8ClampedArray;
+    imageData?: ImageData;
+};
+
+type DepthFrame = {
+    ptr: number;
+    zBufferPtr: number;
+};
+
 type Entity = {
     objPtr: number;
     texturePtr: number;
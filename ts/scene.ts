@@ -0,0 +1,73 @@
+import { WasmRasterizer } from "./rasterizer.js";
+import { Vec3 } from "./utils.js";
+
+export const imageWidth = 800;
+export const imageHeight = 800;
+export const imageChannels = 4;
+const frameCount = 2;
+const samples = 4;
+const vFov = 20.0;
+
+const wasmImportUrl = "./wasm/rasterizer.wasm";
+const objUrl = "./3d/head.obj";
+const textureUrl = "./img/head_texture_smol.png";
+
+const lookFrom: Vec3 = [0.0, 0.0, 0.0];
+const lookAt: Vec3 = [0.0, 0.0, -1.0];
+const vup: Vec3 = [0.0, 1.0, 0.0];
+
+const initPosition = [0.0, 0.0, -3.0] as Vec3;
+const initRotation = [0.0, 0.0, 0.0] as Vec3;
+const initHeight = 1.0;
+
+const rotation = [0.0, 5.0, 0.0] as Vec3;
+
+let firstPixelLogged = false;
+
+// urls are resolved against baseUrl, a worker script does not share the
+// page's location. returns before the model is in, frames draw it as it
+// streams
+export const setupScene = async (
+    rasterizer: WasmRasterizer,
+    baseUrl: string,
+): Promise<void> => {
+    const resolve = (url: string) => new URL(url, baseUrl).href;
+
+    await rasterizer.initializeWasmImport(resolve(wasmImportUrl));
+
+    rasterizer.initializeBuffers(
+        imageWidth,
+        imageHeight,
+        imageChannels,
+        frameCount,
+        samples,
+    );
+
+    rasterizer.setCamera(vFov, lookFrom, lookAt, vup);
+
+    rasterizer
+        .pushEntity(
+            resolve(objUrl),
+            resolve(textureUrl),
+            initPosition,
+            initRotation,
+            initHeight,
+        )
+        .then(() =>
+            console.log(`model loaded at ${performance.now().toFixed(0)} ms`),
+        );
+};
+
+export const updateScene = (rasterizer: WasmRasterizer): void => {
+    // times are from navigation start, or worker start in a worker
+    if (!firstPixelLogged && rasterizer.firstPixelTime !== undefined) {
+        console.log(
+            `first pixel at ${rasterizer.firstPixelTime.toFixed(0)} ms`,
+        );
+        firstPixelLogged = true;
+    }
+
+    if (rasterizer.entityCount > 0) {
+        rasterizer.rotateEntity(0, rotation);
+    }
+};
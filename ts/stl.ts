@@ -1,59 +1,20 @@
-export interface verticesInformation {
-    faceCount: number;
-    verticesPtr: number;
-    vertices: Float32Array;
-}
+import { Allocator } from "./utils.js";
 
-export const loadSTL = async (
-    stl_url: string,
-    malloc: Function,
-    memoryBuffer: ArrayBuffer,
-): Promise<verticesInformation | null> => {
-    return fetch(stl_url)
-        .then((response) => response.arrayBuffer())
-        .then((arrayBuffer) => {
-            return parseBinarySTL(arrayBuffer, malloc, memoryBuffer);
-        })
-        .catch((error) => {
-            console.error("error fetching stl", error);
-            return null;
-        });
-};
-
-export const parseBinarySTL = (
-    stlByteArray: ArrayBuffer,
-    malloc: Function,
-    memoryBuffer: ArrayBuffer,
-): verticesInformation => {
-    const stlDataView = new DataView(stlByteArray);
-    const faceCount = stlDataView.getUint32(80, true);
-    const verticesPtr = malloc(faceCount * 12 * Float32Array.BYTES_PER_ELEMENT);
-    let offset = 84;
+// like parseOBJ, stl_parse welds the faces and builds the object over the
+// copied bytes. memory must have room for them, stl_parse grows it for the
+// object
+export const parseSTL = (
+    stlFile: Uint8Array,
+    malloc: Allocator,
+    memory: ArrayBuffer,
+    stlParse: (bytesPtr: number, size: number) => number,
+): number => {
+    const bytesPtr = malloc(stlFile.length);
+    new Uint8Array(memory, bytesPtr, stlFile.length).set(stlFile);
 
-    let vertices = new Float32Array(memoryBuffer, verticesPtr, faceCount * 12); // each face has 12 floats: n, v1, v2, v3
-
-    for (let i = 0; i < faceCount; i++) {
-        for (let j = 0; j < 4; j++) {
-            vertices[i * 12 + j * 3 + 0] = -stlDataView.getFloat32(
-                offset + 0,
-                true,
-            );
-            vertices[i * 12 + j * 3 + 2] = stlDataView.getFloat32(
-                offset + 4,
-                true,
-            );
-            vertices[i * 12 + j * 3 + 1] = stlDataView.getFloat32(
-                offset + 8,
-                true,
-            );
-            offset += 12;
-        }
-        offset += 2;
+    const objPtr = stlParse(bytesPtr, stlFile.length);
+    if (objPtr === 0) {
+        throw new Error("invalid or too large stl file");
     }
-
-    return {
-        faceCount: faceCount,
-        verticesPtr: verticesPtr,
-        vertices: vertices,
-    };
+    return objPtr;
 };
@@ -1,4 +1,48 @@
-import { Uint32, Allocator } from "./utils.js";
+import { Uint32, Allocator, UINT32_SIZE } from "./utils.js";
+
+export const TEXTURE_MAX_LEVELS = 16;
+
+// what a fetch outside [0, 1] reads, see sampler.h
+export enum AddressMode {
+    Wrap = 0,
+    Clamp = 1,
+    Mirror = 2,
+}
+
+export enum Filter {
+    Nearest = 0,
+    // blends the 2x2 texels around the sample
+    Bilinear = 1,
+}
+
+// texels per block side is 1 << TEXTURE_BLOCK_SHIFT, see texture.h
+export const TEXTURE_BLOCK_SHIFT = 2;
+
+export class TextureLevelStruct {
+    readonly width: Uint32;
+    readonly height: Uint32;
+
+    readonly imagePtr: Uint32;
+
+    readonly blocksX: Uint32;
+
+    readonly ptr: number;
+
+    constructor(view: DataView, malloc: Allocator) {
+        this.width = new Uint32(view, malloc);
+        this.height = new Uint32(view, malloc);
+
+        this.imagePtr = new Uint32(view, malloc);
+
+        this.blocksX = new Uint32(view, malloc);
+
+        this.ptr = this.width.ptr;
+    }
+}
+
+// eight fields and the level array, every field a Uint32
+export const TEXTURE_STRUCT_BYTE_SIZE =
+    (8 + 4 * TEXTURE_MAX_LEVELS) * UINT32_SIZE;
 
 export class TextureStruct {
     readonly imageWidth: Uint32;
@@ -7,6 +51,14 @@ export class TextureStruct {
 
     readonly imagePtr: Uint32;
 
+    readonly addressMode: Uint32;
+    readonly filter: Uint32;
+
+    // filled in by texture_build_levels in the wasm module
+    readonly blockShift: Uint32;
+    readonly levelCount: Uint32;
+    readonly levels: TextureLevelStruct[];
+
     readonly ptr: number;
 
     constructor(view: DataView, malloc: Allocator) {
@@ -16,63 +68,124 @@ export class TextureStruct {
 
         this.imagePtr = new Uint32(view, malloc);
 
+        this.addressMode = new Uint32(view, malloc);
+        this.filter = new Uint32(view, malloc);
+
+        this.blockShift = new Uint32(view, malloc);
+        this.levelCount = new Uint32(view, malloc);
+        this.levels = [];
+        for (let i = 0; i < TEXTURE_MAX_LEVELS; i++) {
+            this.levels.push(new TextureLevelStruct(view, malloc));
+        }
+
         this.ptr = this.imageWidth.ptr;
     }
 }
 
+// decoded rgba pixels, row major
+export type TextureSource = {
+    width: number;
+    height: number;
+    data: Uint8Array | Uint8ClampedArray;
+};
+
+// decodes with createImageBitmap and an OffscreenCanvas, so it works on the
+// main thread and in workers alike
 export const loadTexture = async (
     textureURL: string,
+): Promise<TextureSource> => {
+    const response = await fetch(textureURL);
+    if (!response.ok) {
+        throw new Error(`Failed to load image: ${textureURL}`);
+    }
+    const textureImage = await createImageBitmap(await response.blob());
+
+    const canvas = new OffscreenCanvas(textureImage.width, textureImage.height);
+    const context = canvas.getContext("2d");
+    if (!context) {
+        throw new Error("Canvas context not supported");
+    }
+
+    context.drawImage(textureImage, 0, 0);
+
+    const textureData = context.getImageData(
+        0,
+        0,
+        textureImage.width,
+        textureImage.height,
+    ).data;
+
+    return {
+        width: textureImage.width,
+        height: textureImage.height,
+        data: textureData,
+    };
+};
+
+// bytes texture_build_levels writes the mip chain of a width x height rgba
+// image into, see texture_levels_size in mipmap.c
+export const textureLevelsSize = (
+    width: number,
+    height: number,
+    blockShift: number,
+): number => {
+    const blockSize = 1 << blockShift;
+    let size = 0;
+    for (let i = 0; i < TEXTURE_MAX_LEVELS; i++) {
+        const blocksX = (width + blockSize - 1) >> blockShift;
+        const blocksY = (height + blockSize - 1) >> blockShift;
+        size += ((blocksX * blocksY) << (2 * blockShift)) * 4;
+        if (width === 1 && height === 1) {
+            break;
+        }
+        width = width > 1 ? width >> 1 : 1;
+        height = height > 1 ? height >> 1 : 1;
+    }
+    return size;
+};
+
+// everything writeTexture and the mip chain after it allocate
+export const textureAllocationSize = (
+    source: TextureSource,
+    blockShift: number,
+): number =>
+    TEXTURE_STRUCT_BYTE_SIZE +
+    source.data.length +
+    textureLevelsSize(source.width, source.height, blockShift);
+
+// memory and view are used after malloc, so the caller reserves
+// textureAllocationSize first and passes views taken after that
+export const writeTexture = (
+    source: TextureSource,
     malloc: (n: number) => number,
     memory: ArrayBuffer,
     view: DataView,
-): Promise<number> => {
-    return new Promise((resolve, reject) => {
-        const textureImage = new Image();
-        textureImage.crossOrigin = "anonymous";
-        textureImage.src = textureURL;
-
-        textureImage.onload = () => {
-            const canvas = document.createElement("canvas");
-            const context = canvas.getContext("2d");
-            if (!context) {
-                reject(new Error("Canvas context not supported"));
-                return;
-            }
-
-            canvas.width = textureImage.width;
-            canvas.height = textureImage.height;
-
-            context.drawImage(textureImage, 0, 0);
-
-            const textureData = context.getImageData(
-                0,
-                0,
-                textureImage.width,
-                textureImage.height,
-            ).data;
-
-            const textureStruct = new TextureStruct(view, malloc);
-
-            const texturePtr = malloc(textureData.length);
-            const texture = new Uint8Array(
-                memory,
-                texturePtr,
-                textureData.length,
-            );
-
-            texture.set(textureData);
-
-            textureStruct.imageWidth.write(textureImage.width);
-            textureStruct.imageHeight.write(textureImage.height);
-            textureStruct.imageChannels.write(4 | 0);
-
-            textureStruct.imagePtr.write(texturePtr);
-
-            resolve(textureStruct.ptr);
-        };
-
-        textureImage.onerror = (error) => {
-            reject(new Error(`Failed to load image: ${error}`));
-        };
-    });
+    addressMode: AddressMode = AddressMode.Wrap,
+    filter: Filter = Filter.Nearest,
+): number => {
+    const textureStruct = new TextureStruct(view, malloc);
+
+    const texturePtr = malloc(source.data.length);
+    const texture = new Uint8Array(memory, texturePtr, source.data.length);
+
+    texture.set(source.data);
+
+    textureStruct.imageWidth.write(source.width);
+    textureStruct.imageHeight.write(source.height);
+    textureStruct.imageChannels.write(4 | 0);
+
+    textureStruct.imagePtr.write(texturePtr);
+
+    textureStruct.addressMode.write(addressMode);
+    textureStruct.filter.write(filter);
+
+    // row major level 0 only until the mip chain is built
+    textureStruct.blockShift.write(0);
+    textureStruct.levelCount.write(1);
+    textureStruct.levels[0].width.write(source.width);
+    textureStruct.levels[0].height.write(source.height);
+    textureStruct.levels[0].imagePtr.write(texturePtr);
+    textureStruct.levels[0].blocksX.write(source.width);
+
+    return textureStruct.ptr;
 };
@@ -0,0 +1,42 @@
+import { WasmRasterizer } from "./rasterizer.js";
+import { imageWidth, imageHeight, setupScene, updateScene } from "./scene.js";
+
+export type WorkerStartMessage = {
+    baseUrl: string;
+};
+
+// runs the wasm module off the main thread, a slow frame then no longer
+// blocks input or layout on the page. frames go to the page as
+// ImageBitmaps, any message from it after the first asks for the next one
+addEventListener(
+    "message",
+    async (event: MessageEvent<WorkerStartMessage>) => {
+        const { baseUrl } = event.data;
+
+        // turns the front buffer into bitmaps, it is never shown itself
+        const canvas = new OffscreenCanvas(imageWidth, imageHeight);
+        const ctx = canvas.getContext("2d");
+        if (ctx == null) {
+            throw new Error("2d offscreen canvas not supported");
+        }
+
+        const rasterizer = new WasmRasterizer();
+
+        await setupScene(rasterizer, baseUrl);
+        rasterizer.render();
+
+        // hands frame N, the front buffer, to the page, then renders frame
+        // N + 1 into the back buffer while the page shows frame N
+        const present = () => {
+            ctx.putImageData(rasterizer.getImageData(), 0, 0);
+            const bitmap = canvas.transferToImageBitmap();
+            postMessage(bitmap, { transfer: [bitmap] });
+
+            updateScene(rasterizer);
+            rasterizer.render();
+        };
+        addEventListener("message", present);
+        present();
+    },
+    { once: true },
+);